@@ -0,0 +1,474 @@
+// include/appendix/binary_io/binary_io.h
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef NUMERIC_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "../../Linear Algebra/Matrix/Matrix.h"
+#include "../Mapped File/mapped_file.h"
+
+// Binary container for dense matrices, dense vectors and CSR sparse
+// matrices. A file is a 64-byte header followed by one payload:
+//
+//   dense matrix   rows * cols elements, row-major
+//   vector         rows elements (cols == 1)
+//   CSR            row_ptr (rows + 1 x int64), col_idx (nnz x int32, padded
+//                  to 8 bytes), values (nnz elements)
+//
+// Uncompressed payloads start at byte 64 and can be used in place through
+// the map_* functions; compressed payloads have to go through load_*.
+namespace appendix::binary_io {
+
+enum class Kind : std::uint8_t { DenseMatrix = 0, Vector = 1, SparseCsr = 2 };
+
+enum class DType : std::uint8_t {
+    Int32 = 1,
+    Float32 = 2,
+    Float64 = 3,
+    Complex64 = 4,
+    Complex128 = 5,
+};
+
+// None stores the payload verbatim. Zlib byte-shuffles the payload (all
+// first bytes of every element, then all second bytes, ...) and deflates
+// it, which compresses floating-point data far better than deflate alone.
+enum class Compression : std::uint8_t { None = 0, Zlib = 1 };
+
+struct FileHeader {
+    char magic[4];
+    std::uint16_t version;
+    Kind kind;
+    DType dtype;
+    Compression compression;
+    std::uint8_t reserved0[7];
+    std::int64_t rows;
+    std::int64_t cols;
+    std::int64_t nnz;
+    std::uint64_t stored_bytes;   // payload size on disk
+    std::uint64_t raw_bytes;      // payload size after decompression
+    std::uint8_t reserved1[8];
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+
+inline constexpr char file_magic[4] = {'N', 'C', 'B', 'F'};
+inline constexpr std::uint16_t file_version = 1;
+
+template <typename T>
+constexpr DType dtype_of()
+{
+    if constexpr (std::is_same_v<T, std::int32_t>) return DType::Int32;
+    else if constexpr (std::is_same_v<T, float>) return DType::Float32;
+    else if constexpr (std::is_same_v<T, double>) return DType::Float64;
+    else if constexpr (std::is_same_v<T, std::complex<float>>) return DType::Complex64;
+    else if constexpr (std::is_same_v<T, std::complex<double>>) return DType::Complex128;
+    else static_assert(!sizeof(T), "unsupported element type");
+}
+
+// Compressed sparse row storage
+template <typename T>
+struct CsrMatrix {
+    std::int64_t rows = 0;
+    std::int64_t cols = 0;
+    std::vector<std::int64_t> row_ptr;   // rows + 1 entries
+    std::vector<std::int32_t> col_idx;   // nnz entries
+    std::vector<T> values;               // nnz entries
+};
+
+namespace detail {
+
+inline std::size_t padded8(std::size_t bytes) { return (bytes + 7) & ~std::size_t{7}; }
+
+struct FileCloser {
+    void operator()(std::FILE* f) const noexcept { std::fclose(f); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+inline FilePtr open_file(const std::string& path, const char* mode)
+{
+    FilePtr f(std::fopen(path.c_str(), mode));
+    if (!f)
+        throw std::runtime_error("cannot open " + path);
+    return f;
+}
+
+inline void write_bytes(std::FILE* f, const void* data, std::size_t bytes)
+{
+    if (bytes && std::fwrite(data, 1, bytes, f) != bytes)
+        throw std::runtime_error("binary_io: write failed");
+}
+
+inline void read_bytes(std::FILE* f, void* data, std::size_t bytes)
+{
+    if (bytes && std::fread(data, 1, bytes, f) != bytes)
+        throw std::runtime_error("binary_io: unexpected end of file");
+}
+
+inline std::vector<unsigned char> shuffle(const unsigned char* src, std::size_t bytes, std::size_t width)
+{
+    std::vector<unsigned char> out(bytes);
+    const std::size_t n = bytes / width;
+    for (std::size_t b = 0; b < width; ++b)
+        for (std::size_t i = 0; i < n; ++i)
+            out[b * n + i] = src[i * width + b];
+    std::memcpy(out.data() + n * width, src + n * width, bytes - n * width);
+    return out;
+}
+
+inline void unshuffle(const unsigned char* src, unsigned char* dst, std::size_t bytes, std::size_t width)
+{
+    const std::size_t n = bytes / width;
+    for (std::size_t b = 0; b < width; ++b)
+        for (std::size_t i = 0; i < n; ++i)
+            dst[i * width + b] = src[b * n + i];
+    std::memcpy(dst + n * width, src + n * width, bytes - n * width);
+}
+
+inline std::vector<unsigned char> compress(const void* data, std::size_t bytes, std::size_t width)
+{
+#ifdef NUMERIC_WITH_ZLIB
+    auto shuffled = shuffle(static_cast<const unsigned char*>(data), bytes, width);
+    uLongf out_bytes = compressBound(static_cast<uLong>(bytes));
+    std::vector<unsigned char> out(out_bytes);
+    if (compress2(out.data(), &out_bytes, shuffled.data(), static_cast<uLong>(bytes), Z_BEST_SPEED) != Z_OK)
+        throw std::runtime_error("binary_io: zlib compression failed");
+    out.resize(out_bytes);
+    return out;
+#else
+    (void)data; (void)bytes; (void)width;
+    throw std::runtime_error("binary_io: built without zlib support");
+#endif
+}
+
+inline void decompress(const void* src, std::size_t stored, void* dst, std::size_t raw, std::size_t width)
+{
+#ifdef NUMERIC_WITH_ZLIB
+    std::vector<unsigned char> shuffled(raw);
+    uLongf out_bytes = static_cast<uLongf>(raw);
+    if (uncompress(shuffled.data(), &out_bytes, static_cast<const unsigned char*>(src),
+                   static_cast<uLong>(stored)) != Z_OK || out_bytes != raw)
+        throw std::runtime_error("binary_io: corrupt compressed payload");
+    unshuffle(shuffled.data(), static_cast<unsigned char*>(dst), raw, width);
+#else
+    (void)src; (void)stored; (void)dst; (void)raw; (void)width;
+    throw std::runtime_error("binary_io: built without zlib support");
+#endif
+}
+
+template <typename T>
+FileHeader make_header(Kind kind, std::int64_t rows, std::int64_t cols, std::int64_t nnz)
+{
+    FileHeader h{};
+    std::memcpy(h.magic, file_magic, sizeof(file_magic));
+    h.version = file_version;
+    h.kind = kind;
+    h.dtype = dtype_of<T>();
+    h.rows = rows;
+    h.cols = cols;
+    h.nnz = nnz;
+    return h;
+}
+
+template <typename T>
+void check_header(const FileHeader& h, Kind kind)
+{
+    if (std::memcmp(h.magic, file_magic, sizeof(file_magic)) != 0)
+        throw std::runtime_error("binary_io: not a binary_io file");
+    if (h.version != file_version)
+        throw std::runtime_error("binary_io: unsupported file version");
+    if (h.kind != kind)
+        throw std::runtime_error("binary_io: file holds a different kind of object");
+    if (h.dtype != dtype_of<T>())
+        throw std::runtime_error("binary_io: element type does not match the file");
+}
+
+// Payload bytes implied by the shape in a CSR header. Rejects negative
+// sizes and sizes whose byte count would overflow, so a header whose
+// raw_bytes matches this can be trusted to index the payload.
+template <typename T>
+std::uint64_t csr_payload_bytes(const FileHeader& h)
+{
+    if (h.rows < 0 || h.cols < 0 || h.nnz < 0)
+        throw std::runtime_error("binary_io: negative dimensions in header");
+    constexpr std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() / 64;
+    const auto rows = static_cast<std::uint64_t>(h.rows);
+    const auto nnz = static_cast<std::uint64_t>(h.nnz);
+    if (rows >= limit || nnz >= limit)
+        throw std::runtime_error("binary_io: payload size does not match the shape");
+    return (rows + 1) * sizeof(std::int64_t) + padded8(nnz * sizeof(std::int32_t)) + nnz * sizeof(T);
+}
+
+// Payload bytes implied by the shape in a dense matrix or vector header.
+// Both dimensions must fit the int dimensions of Matrix, a vector must
+// have a single column, and the byte count must not overflow.
+template <typename T>
+std::uint64_t dense_payload_bytes(const FileHeader& h, Kind kind)
+{
+    if (h.rows < 0 || h.cols < 0)
+        throw std::runtime_error("binary_io: negative dimensions in header");
+    if (kind == Kind::Vector && h.cols != 1)
+        throw std::runtime_error("binary_io: vector header must have one column");
+    constexpr std::int64_t int_max = std::numeric_limits<int>::max();
+    if (h.rows > int_max || h.cols > int_max)
+        throw std::runtime_error("binary_io: dimensions in header are too large");
+    const auto elements = static_cast<std::uint64_t>(h.rows) * static_cast<std::uint64_t>(h.cols);
+    if (elements > std::numeric_limits<std::uint64_t>::max() / sizeof(T))
+        throw std::runtime_error("binary_io: payload size does not match the shape");
+    return elements * sizeof(T);
+}
+
+// Writes header + payload. width is the element size used by the shuffle
+// filter when the payload is compressed.
+inline void write_file(const std::string& path, FileHeader header, const void* payload, std::size_t bytes,
+                       std::size_t width, Compression compression)
+{
+    auto f = open_file(path, "wb");
+    header.compression = compression;
+    header.raw_bytes = bytes;
+
+    if (compression == Compression::Zlib) {
+        auto packed = compress(payload, bytes, width);
+        header.stored_bytes = packed.size();
+        write_bytes(f.get(), &header, sizeof(header));
+        write_bytes(f.get(), packed.data(), packed.size());
+    } else {
+        header.stored_bytes = bytes;
+        write_bytes(f.get(), &header, sizeof(header));
+        write_bytes(f.get(), payload, bytes);
+    }
+}
+
+template <typename T>
+FileHeader read_header(std::FILE* f, Kind kind)
+{
+    FileHeader header;
+    read_bytes(f, &header, sizeof(header));
+    check_header<T>(header, kind);
+    return header;
+}
+
+// Reads the payload that follows the header into dst (header.raw_bytes
+// bytes), decompressing if needed
+inline void read_payload(std::FILE* f, const FileHeader& header, void* dst, std::size_t width)
+{
+    if (header.compression == Compression::None) {
+        read_bytes(f, dst, header.raw_bytes);
+    } else {
+        std::vector<unsigned char> packed(header.stored_bytes);
+        read_bytes(f, packed.data(), packed.size());
+        decompress(packed.data(), packed.size(), dst, header.raw_bytes, width);
+    }
+}
+
+template <typename T>
+std::vector<unsigned char> csr_payload(const CsrMatrix<T>& m)
+{
+    const std::size_t ptr_bytes = m.row_ptr.size() * sizeof(std::int64_t);
+    const std::size_t idx_bytes = padded8(m.col_idx.size() * sizeof(std::int32_t));
+    std::vector<unsigned char> payload(ptr_bytes + idx_bytes + m.values.size() * sizeof(T));
+    std::memcpy(payload.data(), m.row_ptr.data(), ptr_bytes);
+    std::memcpy(payload.data() + ptr_bytes, m.col_idx.data(), m.col_idx.size() * sizeof(std::int32_t));
+    std::memcpy(payload.data() + ptr_bytes + idx_bytes, m.values.data(), m.values.size() * sizeof(T));
+    return payload;
+}
+
+}
+
+template <typename T>
+void save(const std::string& path, const Matrix<T>& m, Compression compression = Compression::None)
+{
+    const std::size_t count = static_cast<std::size_t>(m.get_num_rows()) * m.get_num_cols();
+    detail::write_file(path, detail::make_header<T>(Kind::DenseMatrix, m.get_num_rows(), m.get_num_cols(), 0),
+                       m.data(), count * sizeof(T), sizeof(T), compression);
+}
+
+template <typename T>
+void save(const std::string& path, const std::vector<T>& v, Compression compression = Compression::None)
+{
+    detail::write_file(path, detail::make_header<T>(Kind::Vector, static_cast<std::int64_t>(v.size()), 1, 0),
+                       v.data(), v.size() * sizeof(T), sizeof(T), compression);
+}
+
+template <typename T>
+void save(const std::string& path, const CsrMatrix<T>& m, Compression compression = Compression::None)
+{
+    if (m.row_ptr.size() != static_cast<std::size_t>(m.rows + 1) || m.col_idx.size() != m.values.size())
+        throw std::invalid_argument("binary_io: inconsistent CSR arrays");
+
+    // The index arrays and the values have different widths, so the CSR
+    // payload is deflated without shuffling
+    auto payload = detail::csr_payload(m);
+    auto header = detail::make_header<T>(Kind::SparseCsr, m.rows, m.cols, static_cast<std::int64_t>(m.values.size()));
+    detail::write_file(path, header, payload.data(), payload.size(), 1, compression);
+}
+
+template <typename T>
+Matrix<T> load_matrix(const std::string& path)
+{
+    auto f = detail::open_file(path, "rb");
+    auto header = detail::read_header<T>(f.get(), Kind::DenseMatrix);
+    if (header.raw_bytes != detail::dense_payload_bytes<T>(header, Kind::DenseMatrix))
+        throw std::runtime_error("binary_io: payload size does not match the shape");
+
+    // The payload goes straight into the matrix buffer
+    Matrix<T> m(static_cast<int>(header.rows), static_cast<int>(header.cols));
+    detail::read_payload(f.get(), header, m.data(), sizeof(T));
+    return m;
+}
+
+template <typename T>
+std::vector<T> load_vector(const std::string& path)
+{
+    auto f = detail::open_file(path, "rb");
+    auto header = detail::read_header<T>(f.get(), Kind::Vector);
+    if (header.raw_bytes != detail::dense_payload_bytes<T>(header, Kind::Vector))
+        throw std::runtime_error("binary_io: payload size does not match the shape");
+
+    std::vector<T> v(static_cast<std::size_t>(header.rows));
+    detail::read_payload(f.get(), header, v.data(), sizeof(T));
+    return v;
+}
+
+template <typename T>
+CsrMatrix<T> load_csr(const std::string& path)
+{
+    auto f = detail::open_file(path, "rb");
+    auto header = detail::read_header<T>(f.get(), Kind::SparseCsr);
+    if (header.raw_bytes != detail::csr_payload_bytes<T>(header))
+        throw std::runtime_error("binary_io: payload size does not match the shape");
+
+    CsrMatrix<T> m;
+    m.rows = header.rows;
+    m.cols = header.cols;
+    m.row_ptr.resize(static_cast<std::size_t>(header.rows + 1));
+    m.col_idx.resize(static_cast<std::size_t>(header.nnz));
+    m.values.resize(static_cast<std::size_t>(header.nnz));
+
+    const std::size_t ptr_bytes = m.row_ptr.size() * sizeof(std::int64_t);
+    const std::size_t idx_bytes = detail::padded8(m.col_idx.size() * sizeof(std::int32_t));
+
+    std::vector<unsigned char> payload(header.raw_bytes);
+    detail::read_payload(f.get(), header, payload.data(), 1);
+    std::memcpy(m.row_ptr.data(), payload.data(), ptr_bytes);
+    std::memcpy(m.col_idx.data(), payload.data() + ptr_bytes, m.col_idx.size() * sizeof(std::int32_t));
+    std::memcpy(m.values.data(), payload.data() + ptr_bytes + idx_bytes, m.values.size() * sizeof(T));
+    return m;
+}
+
+// Read-only view of a dense matrix or vector file. The elements are the
+// page-cache pages of the file itself: opening costs one mmap, and only
+// the pages actually touched are ever read from disk.
+template <typename T>
+class MappedDense {
+public:
+    std::int64_t rows() const noexcept { return header_.rows; }
+    std::int64_t cols() const noexcept { return header_.cols; }
+    std::size_t size() const noexcept { return static_cast<std::size_t>(header_.rows * header_.cols); }
+    const T* data() const noexcept { return reinterpret_cast<const T*>(file_.data() + sizeof(FileHeader)); }
+    const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+    const T& operator()(std::int64_t i, std::int64_t j) const noexcept { return data()[i * header_.cols + j]; }
+    const T* begin() const noexcept { return data(); }
+    const T* end() const noexcept { return data() + size(); }
+
+    Matrix<T> to_matrix() const
+    {
+        return Matrix<T>(static_cast<int>(rows()), static_cast<int>(cols()), data());
+    }
+
+private:
+    template <typename U> friend MappedDense<U> map_matrix(const std::string&);
+    template <typename U> friend MappedDense<U> map_vector(const std::string&);
+
+    static MappedDense<T> open(const std::string& path, Kind kind)
+    {
+        MappedDense<T> view;
+        view.file_ = MappedFile::open(path);
+        if (view.file_.size() < sizeof(FileHeader))
+            throw std::runtime_error("binary_io: file too small");
+        std::memcpy(&view.header_, view.file_.data(), sizeof(FileHeader));
+        detail::check_header<T>(view.header_, kind);
+        if (view.header_.compression != Compression::None)
+            throw std::runtime_error("binary_io: compressed files cannot be mapped; use load_*");
+        // size(), operator() and to_matrix() trust rows and cols from here on
+        if (view.header_.raw_bytes != detail::dense_payload_bytes<T>(view.header_, kind))
+            throw std::runtime_error("binary_io: payload size does not match the shape");
+        if (view.file_.size() < sizeof(FileHeader) + view.header_.raw_bytes)
+            throw std::runtime_error("binary_io: file is truncated");
+        return view;
+    }
+
+    MappedFile file_;
+    FileHeader header_{};
+};
+
+template <typename T>
+MappedDense<T> map_matrix(const std::string& path)
+{
+    return MappedDense<T>::open(path, Kind::DenseMatrix);
+}
+
+template <typename T>
+MappedDense<T> map_vector(const std::string& path)
+{
+    return MappedDense<T>::open(path, Kind::Vector);
+}
+
+// Read-only view of a CSR file; the three arrays point into the mapping
+template <typename T>
+class MappedCsr {
+public:
+    std::int64_t rows() const noexcept { return header_.rows; }
+    std::int64_t cols() const noexcept { return header_.cols; }
+    std::int64_t nnz() const noexcept { return header_.nnz; }
+    const std::int64_t* row_ptr() const noexcept { return reinterpret_cast<const std::int64_t*>(payload()); }
+    const std::int32_t* col_idx() const noexcept
+    {
+        return reinterpret_cast<const std::int32_t*>(payload() + ptr_bytes());
+    }
+    const T* values() const noexcept
+    {
+        return reinterpret_cast<const T*>(payload() + ptr_bytes()
+                                          + detail::padded8(static_cast<std::size_t>(nnz()) * sizeof(std::int32_t)));
+    }
+
+private:
+    template <typename U> friend MappedCsr<U> map_csr(const std::string&);
+
+    const std::byte* payload() const noexcept { return file_.data() + sizeof(FileHeader); }
+    std::size_t ptr_bytes() const noexcept { return static_cast<std::size_t>(rows() + 1) * sizeof(std::int64_t); }
+
+    MappedFile file_;
+    FileHeader header_{};
+};
+
+template <typename T>
+MappedCsr<T> map_csr(const std::string& path)
+{
+    MappedCsr<T> view;
+    view.file_ = MappedFile::open(path);
+    if (view.file_.size() < sizeof(FileHeader))
+        throw std::runtime_error("binary_io: file too small");
+    std::memcpy(&view.header_, view.file_.data(), sizeof(FileHeader));
+    detail::check_header<T>(view.header_, Kind::SparseCsr);
+    if (view.header_.compression != Compression::None)
+        throw std::runtime_error("binary_io: compressed files cannot be mapped; use load_*");
+    // The views index the payload by rows and nnz, so these must agree with it
+    if (view.header_.raw_bytes != detail::csr_payload_bytes<T>(view.header_))
+        throw std::runtime_error("binary_io: payload size does not match the shape");
+    if (view.file_.size() < sizeof(FileHeader) + view.header_.raw_bytes)
+        throw std::runtime_error("binary_io: file is truncated");
+    return view;
+}
+
+}
@@ -8,7 +8,7 @@
 #include <string>
 #include <vector>
 
-std::vector<std::string> split(const std::string &s, char delimiter) {
+inline std::vector<std::string> split(const std::string &s, char delimiter) {
     std::vector<std::string> tokens;
     std::string token;
     std::istringstream tokenStream(s);
@@ -18,7 +18,7 @@ std::vector<std::string> split(const std::string &s, char delimiter) {
     return tokens;
 }
 
-std::vector<std::vector<double>> read_csv(const std::string &filename) {
+inline std::vector<std::vector<double>> read_csv(const std::string &filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cout << "File could not be opened!" << std::endl;
@@ -0,0 +1,305 @@
+// include/appendix/instrumentation/instrumentation.h
+#pragma once
+
+#include <string>
+
+// Opt-in FLOP / bandwidth / wall-time counters for the numerical kernels.
+//
+// Build with -DNUMERIC_INSTRUMENT to enable. Instrumented code opens a scope
+//
+//     NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.multiply", flops, bytes);
+//     ...
+//     NUMERIC_INSTRUMENT_ADD(probe, more_flops, more_bytes);
+//
+// and when the scope closes its call, FLOPs, bytes and elapsed time are
+// added to a per-thread table. Only the owning thread writes its table, so
+// recording is lock-free; the registry mutex is taken once per thread (on
+// first use and at exit) and by readers such as to_json(). reset() never
+// writes another thread's counters: it records their current values as a
+// baseline that later reads subtract, so it is safe while instrumented
+// code is running (operations in flight count after the reset).
+//
+// Scopes nest: the time of an outer operation (e.g. matrix.expm) includes
+// the inner operations it triggers (matrix.multiply), which are recorded
+// under their own names as well.
+//
+// Without NUMERIC_INSTRUMENT the macros expand to nothing and do not
+// evaluate their arguments. The macro has to be defined the same way in
+// every translation unit of a program.
+
+#ifdef NUMERIC_INSTRUMENT
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace appendix::instrumentation {
+
+inline constexpr int max_operations = 128;
+
+struct Totals {
+    std::uint64_t calls = 0;
+    std::uint64_t flops = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t nanoseconds = 0;
+
+    Totals& operator+=(const Totals& other) {
+        calls += other.calls;
+        flops += other.flops;
+        bytes += other.bytes;
+        nanoseconds += other.nanoseconds;
+        return *this;
+    }
+
+    // Counters only grow, so a later reading minus an earlier one of the
+    // same slot never wraps
+    Totals operator-(const Totals& earlier) const {
+        return Totals{calls - earlier.calls, flops - earlier.flops, bytes - earlier.bytes,
+                      nanoseconds - earlier.nanoseconds};
+    }
+
+    double seconds() const { return nanoseconds * 1e-9; }
+    double gflops() const { return nanoseconds ? double(flops) / nanoseconds : 0.0; }
+    double gbytes_per_second() const { return nanoseconds ? double(bytes) / nanoseconds : 0.0; }
+};
+
+namespace detail {
+
+// Counters of one operation on one thread. Single writer, so plain
+// load/store with relaxed ordering is enough and never contends.
+struct Slot {
+    std::atomic<std::uint64_t> calls{0}, flops{0}, bytes{0}, nanoseconds{0};
+
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    Totals read() const {
+        return Totals{calls.load(std::memory_order_relaxed), flops.load(std::memory_order_relaxed),
+                      bytes.load(std::memory_order_relaxed), nanoseconds.load(std::memory_order_relaxed)};
+    }
+};
+
+struct ThreadTable;
+
+class Registry {
+    public:
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    // Slot index of an operation name; called once per call site
+    int slot_for(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < count; ++i) {
+            if (std::strcmp(names[i], name) == 0) return i;
+        }
+        if (count == max_operations) {
+            throw std::length_error("too many instrumented operations");
+        }
+        names[count] = name;
+        return count++;
+    }
+
+    void attach(ThreadTable* table);
+    void detach(ThreadTable* table);
+
+    // Per-operation totals, either summed over all threads or for one
+    // live thread (thread_index as reported by threads())
+    std::vector<std::pair<std::string, Totals>> totals(int thread_index = -1);
+    std::vector<int> threads();
+    void reset();
+
+    private:
+    std::mutex mutex;
+    std::array<const char*, max_operations> names{};
+    int count = 0;
+    int next_thread_index = 0;
+    std::vector<ThreadTable*> live;
+    std::array<Totals, max_operations> retired{};   // threads that have exited
+};
+
+struct ThreadTable {
+    std::array<Slot, max_operations> slots;
+    std::array<Totals, max_operations> baseline{};   // slot values at the last reset, under the registry mutex
+    int index = -1;
+
+    Totals since_reset(int i) const { return slots[i].read() - baseline[i]; }
+
+    ThreadTable() { Registry::instance().attach(this); }
+    ~ThreadTable() { Registry::instance().detach(this); }
+
+    static ThreadTable& local() {
+        thread_local ThreadTable table;
+        return table;
+    }
+};
+
+inline void Registry::attach(ThreadTable* table) {
+    std::lock_guard<std::mutex> lock(mutex);
+    table->index = next_thread_index++;
+    live.push_back(table);
+}
+
+inline void Registry::detach(ThreadTable* table) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < count; ++i) {
+        retired[i] += table->since_reset(i);
+    }
+    live.erase(std::remove(live.begin(), live.end(), table), live.end());
+}
+
+inline std::vector<std::pair<std::string, Totals>> Registry::totals(int thread_index) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::pair<std::string, Totals>> result;
+    for (int i = 0; i < count; ++i) {
+        Totals sum = thread_index < 0 ? retired[i] : Totals{};
+        for (const ThreadTable* table : live) {
+            if (thread_index < 0 || table->index == thread_index) {
+                sum += table->since_reset(i);
+            }
+        }
+        if (sum.calls != 0) {
+            result.emplace_back(names[i], sum);
+        }
+    }
+    return result;
+}
+
+inline std::vector<int> Registry::threads() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<int> indices;
+    for (const ThreadTable* table : live) {
+        indices.push_back(table->index);
+    }
+    return indices;
+}
+
+inline void Registry::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    retired.fill(Totals{});
+    for (ThreadTable* table : live) {
+        for (int i = 0; i < count; ++i) {
+            table->baseline[i] = table->slots[i].read();
+        }
+    }
+}
+
+}
+
+// Times one call of an operation and records it on scope exit
+class Probe {
+    public:
+    Probe(int slot, std::uint64_t flops, std::uint64_t bytes)
+        : slot(detail::ThreadTable::local().slots[slot]), flops(flops), bytes(bytes),
+          start(std::chrono::steady_clock::now()) {}
+
+    ~Probe() {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        detail::Slot::bump(slot.calls, 1);
+        detail::Slot::bump(slot.flops, flops);
+        detail::Slot::bump(slot.bytes, bytes);
+        detail::Slot::bump(slot.nanoseconds,
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    Probe(const Probe&) = delete;
+    Probe& operator=(const Probe&) = delete;
+
+    // For work that is only known once the operation has run (iterations)
+    void add(std::uint64_t more_flops, std::uint64_t more_bytes) {
+        flops += more_flops;
+        bytes += more_bytes;
+    }
+
+    private:
+    detail::Slot& slot;
+    std::uint64_t flops;
+    std::uint64_t bytes;
+    std::chrono::steady_clock::time_point start;
+};
+
+inline constexpr bool enabled = true;
+
+// Totals per operation over all threads, including threads that have exited
+inline std::vector<std::pair<std::string, Totals>> totals() {
+    return detail::Registry::instance().totals();
+}
+
+inline void reset() { detail::Registry::instance().reset(); }
+
+// {"enabled": true, "operations": {name: {...}}, "threads": [{"thread": i, "operations": {...}}]}
+inline void write_json(std::ostream& out) {
+    auto write_operations = [&out](const std::vector<std::pair<std::string, Totals>>& ops) {
+        out << '{';
+        for (std::size_t i = 0; i < ops.size(); ++i) {
+            const Totals& t = ops[i].second;
+            out << (i ? ", " : "") << '"' << ops[i].first << "\": {"
+                << "\"calls\": " << t.calls
+                << ", \"flops\": " << t.flops
+                << ", \"bytes\": " << t.bytes
+                << ", \"seconds\": " << t.seconds()
+                << ", \"gflops\": " << t.gflops()
+                << ", \"gbytes_per_second\": " << t.gbytes_per_second() << '}';
+        }
+        out << '}';
+    };
+
+    detail::Registry& registry = detail::Registry::instance();
+    out << "{\"enabled\": true, \"operations\": ";
+    write_operations(registry.totals());
+    out << ", \"threads\": [";
+    const std::vector<int> threads = registry.threads();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        out << (i ? ", " : "") << "{\"thread\": " << threads[i] << ", \"operations\": ";
+        write_operations(registry.totals(threads[i]));
+        out << '}';
+    }
+    out << "]}";
+}
+
+inline std::string to_json() {
+    std::ostringstream out;
+    write_json(out);
+    return out.str();
+}
+
+}
+
+#define NUMERIC_INSTRUMENT_CONCAT_(a, b) a##b
+#define NUMERIC_INSTRUMENT_CONCAT(a, b) NUMERIC_INSTRUMENT_CONCAT_(a, b)
+
+#define NUMERIC_INSTRUMENT_SCOPE(probe, name, flops, bytes)                                        \
+    static const int NUMERIC_INSTRUMENT_CONCAT(probe, _slot) =                                     \
+        ::appendix::instrumentation::detail::Registry::instance().slot_for(name);                   \
+    ::appendix::instrumentation::Probe probe(NUMERIC_INSTRUMENT_CONCAT(probe, _slot),              \
+                                             static_cast<std::uint64_t>(flops),                     \
+                                             static_cast<std::uint64_t>(bytes))
+
+#define NUMERIC_INSTRUMENT_ADD(probe, flops, bytes) \
+    probe.add(static_cast<std::uint64_t>(flops), static_cast<std::uint64_t>(bytes))
+
+#else
+
+namespace appendix::instrumentation {
+
+inline constexpr bool enabled = false;
+
+inline void reset() {}
+inline std::string to_json() { return "{\"enabled\": false}"; }
+
+}
+
+#define NUMERIC_INSTRUMENT_SCOPE(probe, name, flops, bytes) static_cast<void>(0)
+#define NUMERIC_INSTRUMENT_ADD(probe, flops, bytes) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,149 @@
+// include/appendix/mapped_file/mapped_file.h
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace appendix {
+
+// RAII owner of a POSIX shared file mapping. The mapping is MAP_SHARED, so
+// writes go straight to the page cache and reach the file without an
+// explicit copy; flush() forces them to disk.
+class MappedFile {
+public:
+    enum class Mode { ReadOnly, ReadWrite };
+
+    MappedFile() = default;
+
+    // Maps an existing file in full
+    static MappedFile open(const std::string& path, Mode mode = Mode::ReadOnly)
+    {
+        int fd = ::open(path.c_str(), mode == Mode::ReadOnly ? O_RDONLY : O_RDWR);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path + ": " + std::strerror(errno));
+        }
+        return MappedFile(fd, static_cast<std::size_t>(st.st_size), mode, path);
+    }
+
+    // Creates (or truncates) a file of the given size and maps it read-write
+    static MappedFile create(const std::string& path, std::size_t size)
+    {
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::runtime_error("cannot create " + path + ": " + std::strerror(errno));
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot resize " + path + ": " + std::strerror(errno));
+        }
+        return MappedFile(fd, size, Mode::ReadWrite, path);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            fd_ = std::exchange(other.fd_, -1);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { release(); }
+
+    [[nodiscard]] std::byte* data() noexcept { return data_; }
+    [[nodiscard]] const std::byte* data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool is_open() const noexcept { return data_ != nullptr; }
+
+    // Hints that [offset, offset + length) will be read soon
+    void will_need(std::size_t offset, std::size_t length) const noexcept
+    {
+        advise(offset, length, MADV_WILLNEED);
+    }
+
+    // Hints that [offset, offset + length) is done with; dirty pages stay
+    // in the page cache and are still written back
+    void dont_need(std::size_t offset, std::size_t length) const noexcept
+    {
+        advise(offset, length, MADV_DONTNEED);
+    }
+
+    // Hints a front-to-back scan over the whole mapping
+    void sequential() const noexcept { advise(0, size_, MADV_SEQUENTIAL); }
+
+    void flush()
+    {
+        if (data_ && ::msync(data_, size_, MS_SYNC) != 0)
+            throw std::runtime_error(std::string("msync failed: ") + std::strerror(errno));
+    }
+
+private:
+    MappedFile(int fd, std::size_t size, Mode mode, const std::string& path)
+        : fd_(fd), size_(size)
+    {
+        if (size_ == 0)
+            return;
+
+        int prot = mode == Mode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* p = ::mmap(nullptr, size_, prot, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd_);
+            fd_ = -1;
+            throw std::runtime_error("cannot map " + path + ": " + std::strerror(errno));
+        }
+        data_ = static_cast<std::byte*>(p);
+    }
+
+    // madvise needs a page-aligned start, so round the range outwards
+    void advise(std::size_t offset, std::size_t length, int advice) const noexcept
+    {
+        if (!data_ || offset >= size_)
+            return;
+        static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t begin = offset - offset % page;
+        std::size_t end = std::min(size_, offset + length);
+        ::madvise(data_ + begin, end - begin, advice);
+    }
+
+    void release() noexcept
+    {
+        if (data_)
+            ::munmap(data_, size_);
+        if (fd_ >= 0)
+            ::close(fd_);
+        data_ = nullptr;
+        fd_ = -1;
+        size_ = 0;
+    }
+
+    int fd_ = -1;
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}
@@ -0,0 +1,236 @@
+#include "bench_common.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "../Differentiation/AutoDiff/autodiff.h"
+#include "../Differentiation/AutoDiff/reverse_mode.h"
+#include "../Differentiation/AutoDiff/dual.h"
+#include "../Differentiation/AutoDiff/expression_pool.h"
+#include "../Differentiation/AutoDiff/hessian.h"
+
+namespace {
+
+using Expr = expression<double>*;
+using Plus = plus<double, Expr, Expr>;
+using Times = multiply<double, Expr, Expr>;
+
+// f(x) = sum_i x_i x_{i+1} over n variables, as a chain of binary nodes
+struct ChainGraph {
+    std::vector<std::unique_ptr<variable<double>>> vars;
+    std::vector<std::unique_ptr<expression<double>>> nodes;
+    Expr root = nullptr;
+
+    explicit ChainGraph(int n)
+    {
+        for (int i = 0; i < n; ++i)
+            vars.push_back(std::make_unique<variable<double>>(1.0 + 0.01 * i));
+
+        for (int i = 0; i + 1 < n; ++i) {
+            nodes.push_back(std::make_unique<Times>(vars[i].get(), vars[i + 1].get()));
+            Expr term = nodes.back().get();
+            if (root) {
+                nodes.push_back(std::make_unique<Plus>(root, term));
+                root = nodes.back().get();
+            } else {
+                root = term;
+            }
+        }
+    }
+};
+
+// Full gradient in forward mode: one sweep over the graph per variable,
+// so the cost grows as n * graph size
+void BM_ForwardGradient(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    ChainGraph g(n);
+    std::vector<double> grad(n);
+
+    for (auto _ : state) {
+        for (int i = 0; i < n; ++i)
+            grad[i] = g.root->evaluate_and_derive(g.vars[i].get()).partial;
+        benchmark::DoNotOptimize(grad.data());
+    }
+    state.counters["node_visits_per_second"] = bench::rate(double(n) * (g.nodes.size() + n));
+}
+BENCHMARK(BM_ForwardGradient)->RangeMultiplier(4)->Range(4, 1024)->Apply(bench::thread_sweep);
+
+// f_{k+1} = f_k * y + f_k: a DAG whose path count doubles per level, so
+// only per-pass caching keeps evaluation linear in the depth
+void BM_SharedSubexpressions(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    variable<double> x(1.0), y(1.0 + 1e-3);
+    std::vector<std::unique_ptr<expression<double>>> nodes;
+    Expr f = &x;
+    for (int k = 0; k < depth; ++k) {
+        nodes.push_back(std::make_unique<Times>(f, &y));
+        nodes.push_back(std::make_unique<Plus>(nodes.back().get(), f));
+        f = nodes.back().get();
+    }
+
+    for (auto _ : state) {
+        auto vp = f->evaluate_and_derive(&x);
+        benchmark::DoNotOptimize(vp);
+    }
+    state.counters["nodes_visited_per_pass"] = static_cast<double>(evaluation_pass::last_nodes_visited());
+}
+BENCHMARK(BM_SharedSubexpressions)->RangeMultiplier(4)->Range(4, 1024);
+
+// A single directional derivative
+void BM_ForwardPartial(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    ChainGraph g(n);
+
+    for (auto _ : state) {
+        auto vp = g.root->evaluate_and_derive(g.vars[0].get());
+        benchmark::DoNotOptimize(vp);
+    }
+}
+BENCHMARK(BM_ForwardPartial)->RangeMultiplier(4)->Range(4, 4096);
+
+// Full gradient in reverse mode: record once, sweep back once, so the cost
+// is a constant multiple of one evaluation whatever n is
+void BM_ReverseGradient(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::vector<double> x(n), grad(n);
+    for (int i = 0; i < n; ++i) x[i] = 1.0 + 0.01 * i;
+    auto f = [](const std::vector<autodiff::reverse_var<double>>& v) {
+        autodiff::reverse_var<double> sum = 0.0;
+        for (std::size_t i = 0; i + 1 < v.size(); ++i) sum += v[i] * v[i + 1];
+        return sum;
+    };
+    autodiff::tape<double> tape;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(autodiff::value_and_gradient(f, x, grad, tape));
+        benchmark::DoNotOptimize(grad.data());
+    }
+    state.counters["tape_entries"] = static_cast<double>(tape.size());
+}
+BENCHMARK(BM_ReverseGradient)->RangeMultiplier(4)->Range(4, 1024)->Apply(bench::thread_sweep);
+
+// Full gradient with N-lane dual numbers: ceil(n / N) forward passes
+template <int N>
+void BM_DualGradient(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::vector<double> x(n);
+    for (int i = 0; i < n; ++i) x[i] = 1.0 + 0.01 * i;
+    auto f = [](const std::vector<autodiff::dual<double, N>>& v) {
+        autodiff::dual<double, N> sum = 0.0;
+        for (std::size_t i = 0; i + 1 < v.size(); ++i) sum += v[i] * v[i + 1];
+        return sum;
+    };
+
+    for (auto _ : state) {
+        auto grad = autodiff::gradient<N>(f, x);
+        benchmark::DoNotOptimize(grad.data());
+    }
+    state.counters["passes"] = static_cast<double>((n + N - 1) / N);
+}
+BENCHMARK(BM_DualGradient<1>)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(BM_DualGradient<4>)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK(BM_DualGradient<8>)->RangeMultiplier(4)->Range(4, 256);
+
+// The ChainGraph function built in a flat expression pool
+struct PoolChain {
+    autodiff::expression_pool<double> pool;
+    autodiff::pool_node<double> root;
+
+    explicit PoolChain(int n)
+    {
+        std::vector<autodiff::pool_node<double>> vars;
+        for (int i = 0; i < n; ++i) vars.push_back(pool.variable(1.0 + 0.01 * i));
+        root = vars[0] * vars[1];
+        for (int i = 1; i + 1 < n; ++i) root = root + vars[i] * vars[i + 1];
+    }
+};
+
+// Same single directional derivative as BM_ForwardPartial, as a flat loop
+void BM_PoolPartial(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    PoolChain g(n);
+    const autodiff::pool_node<double> x0{&g.pool, 0};
+
+    for (auto _ : state) {
+        double partial;
+        benchmark::DoNotOptimize(g.pool.value_and_partial(g.root, x0, partial));
+        benchmark::DoNotOptimize(partial);
+    }
+    state.counters["nodes"] = static_cast<double>(g.pool.size());
+}
+BENCHMARK(BM_PoolPartial)->RangeMultiplier(4)->Range(4, 4096);
+
+void BM_PoolGradient(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    PoolChain g(n);
+    std::vector<double> grad;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(g.pool.value_and_gradient(g.root, grad));
+        benchmark::DoNotOptimize(grad.data());
+    }
+}
+BENCHMARK(BM_PoolGradient)->RangeMultiplier(4)->Range(4, 1024);
+
+// Building and releasing a graph: appends into retained storage
+void BM_PoolBuildRelease(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    autodiff::expression_pool<double> pool;
+
+    for (auto _ : state) {
+        pool.release();
+        auto sum = pool.variable(1.0);
+        for (int i = 1; i < n; ++i) sum = sum + pool.variable(1.0 + 0.01 * i) * sum;
+        benchmark::DoNotOptimize(sum.index);
+    }
+    state.SetItemsProcessed(state.iterations() * (3LL * n - 2));
+}
+BENCHMARK(BM_PoolBuildRelease)->RangeMultiplier(4)->Range(4, 4096);
+
+// Extended Rosenbrock: tridiagonal Hessian
+auto rosenbrock = [](const auto& x) {
+    auto sum = x[0] * 0.0;
+    for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+        auto a = 1.0 - x[i];
+        auto b = x[i + 1] - x[i] * x[i];
+        sum += a * a + 100.0 * b * b;
+    }
+    return sum;
+};
+
+void BM_DenseHessian(benchmark::State& state)
+{
+    std::vector<double> x(state.range(0), 0.5);
+    for (auto _ : state) {
+        auto h = autodiff::hessian<4>(rosenbrock, x);
+        benchmark::DoNotOptimize(h.data());
+    }
+}
+BENCHMARK(BM_DenseHessian)->RangeMultiplier(4)->Range(16, 256);
+
+// Pattern and coloring computed once; each evaluation costs one
+// Hessian-vector product per color (3 for any n)
+void BM_SparseHessian(benchmark::State& state)
+{
+    std::vector<double> x(state.range(0), 0.5);
+    const autodiff::hessian_pattern pattern = autodiff::hessian_sparsity(rosenbrock, x);
+    const std::vector<int> colors = autodiff::color_columns(pattern);
+
+    for (auto _ : state) {
+        auto h = autodiff::sparse_hessian<4>(rosenbrock, x, pattern, colors);
+        benchmark::DoNotOptimize(h.values.data());
+    }
+    state.counters["colors"] = static_cast<double>(*std::max_element(colors.begin(), colors.end()) + 1);
+}
+BENCHMARK(BM_SparseHessian)->RangeMultiplier(4)->Range(16, 4096);
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+namespace bench {
+
+// Thread counts 1, 2, 4, ... up to the hardware concurrency. Every thread
+// runs its own copy of the benchmark body, so the per-thread rate shows how
+// well a kernel scales when cores share caches and memory bandwidth.
+inline void thread_sweep(benchmark::internal::Benchmark* b)
+{
+    const int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int t = 1; t < max_threads; t *= 2)
+        b->Threads(t);
+    b->Threads(max_threads);
+}
+
+// Counter reported as a rate per second of wall time
+inline benchmark::Counter rate(double amount)
+{
+    return benchmark::Counter(amount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Silences std::cout for the lifetime of the object; some solvers report
+// convergence on stdout, which would corrupt console output of the runner
+class QuietCout {
+public:
+    QuietCout() : saved(std::cout.rdbuf(&null)) {}
+    ~QuietCout() { std::cout.rdbuf(saved); }
+    QuietCout(const QuietCout&) = delete;
+    QuietCout& operator=(const QuietCout&) = delete;
+
+private:
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+    };
+    NullBuffer null;
+    std::streambuf* saved;
+};
+
+}
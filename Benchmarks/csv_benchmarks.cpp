@@ -0,0 +1,62 @@
+#include "bench_common.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../Appendix/CSV Reader/csv.h"
+
+namespace {
+
+// Writes a header line plus range(0) rows of range(1) numeric columns
+std::string write_csv(int rows, int cols)
+{
+    const auto path = std::filesystem::temp_directory_path()
+                    / ("numeric_bench_" + std::to_string(rows) + "x" + std::to_string(cols) + ".csv");
+    std::ofstream out(path);
+    for (int j = 0; j < cols; ++j)
+        out << (j ? "," : "") << "c" << j;
+    out << '\n';
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j)
+            out << (j ? "," : "") << (i * 0.001 + j * 1.5);
+        out << '\n';
+    }
+    return path.string();
+}
+
+void BM_ReadCsv(benchmark::State& state)
+{
+    const std::string path = write_csv(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+    const auto file_bytes = static_cast<int64_t>(std::filesystem::file_size(path));
+
+    for (auto _ : state) {
+        auto data = read_csv(path);
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * file_bytes);
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_ReadCsv)
+    ->ArgsProduct({{1'000, 10'000, 100'000}, {4, 16}})
+    ->ArgNames({"rows", "cols"})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_Split(benchmark::State& state)
+{
+    std::string line;
+    for (int j = 0; j < state.range(0); ++j)
+        line += (j ? "," : "") + std::to_string(j * 1.25);
+
+    for (auto _ : state) {
+        auto tokens = split(line, ',');
+        benchmark::DoNotOptimize(tokens.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_Split)->RangeMultiplier(4)->Range(4, 1024);
+
+}
@@ -0,0 +1,95 @@
+#include "bench_common.h"
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../Differentiation/Finite Difference/finite_difference_grid.hpp"
+#include "../Differentiation/Finite Difference/finite_difference_jacobian.hpp"
+
+namespace {
+
+// First derivative, 7-point stencil, along range(0) of a 64 x 128 x 256 grid
+void BM_GridDifference(benchmark::State& state)
+{
+    const auto axis = static_cast<std::size_t>(state.range(0));
+    const std::array<std::size_t, 3> extents{64, 128, 256};
+    const std::size_t points = extents[0] * extents[1] * extents[2];
+    std::vector<double> u(points), du(points);
+    for (std::size_t p = 0; p < points; ++p)
+        u[p] = std::sin(0.001 * static_cast<double>(p));
+
+    for (auto _ : state) {
+        GridDifference<1, 3>::apply(u.data(), extents, axis, 0.01, du.data());
+        benchmark::DoNotOptimize(du.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["points_per_second"] = bench::rate(static_cast<double>(points));
+}
+BENCHMARK(BM_GridDifference)->DenseRange(0, 2)->ArgName("axis");
+
+// The point-wise API on the same number of points, for comparison
+void BM_PointwiseDifference(benchmark::State& state)
+{
+    const std::size_t points = 64 * 128 * 256;
+    auto f = [](double x) { return std::sin(x); };
+    for (auto _ : state) {
+        double sum = 0;
+        for (std::size_t p = 0; p < points; ++p)
+            sum += FiniteDifference<Scheme::Centered, 1, 3>::differentiate(f, 0.001 * static_cast<double>(p), 0.01);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["points_per_second"] = bench::rate(static_cast<double>(points));
+}
+BENCHMARK(BM_PointwiseDifference);
+
+// Ridders derivative with the default evaluation cap
+void BM_AdaptiveDerivative(benchmark::State& state)
+{
+    auto f = [](double x) { return std::exp(std::sin(x)); };
+    AdaptiveDerivative<double> r{};
+    for (auto _ : state) {
+        r = adaptive_derivative(f, 0.7, 0.5);
+        benchmark::DoNotOptimize(r);
+    }
+    state.counters["evaluations"] = static_cast<double>(r.evaluations);
+    state.counters["error"] = r.error;
+}
+BENCHMARK(BM_AdaptiveDerivative);
+
+// Tridiagonal system of range(0) equations; range(1) = 1 uses the
+// sparsity pattern (3 colors) instead of one column per evaluation
+void BM_FdJacobian(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const bool colored = state.range(1) != 0;
+    std::atomic<std::size_t> calls{0};   // the columns may run on several threads
+    auto system = [n, &calls](const auto& v) {
+        ++calls;
+        using S = typename std::decay_t<decltype(v)>::value_type;
+        std::vector<S> r(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            r[i] = (3.0 - 2.0 * v[i]) * v[i] + 1.0;
+            if (i > 0) r[i] -= v[i - 1];
+            if (i + 1 < n) r[i] -= 2.0 * v[i + 1];
+        }
+        return r;
+    };
+    JacobianPattern pattern{n, n, std::vector<std::vector<std::size_t>>(n)};
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = (i > 0 ? i - 1 : 0); j <= std::min(i + 1, n - 1); ++j) pattern.nonzeros[i].push_back(j);
+    const std::vector<double> x(n, 0.5);
+
+    for (auto _ : state) {
+        calls = 0;
+        auto jac = colored ? fd_jacobian(system, x, pattern, JacobianMethod::ComplexStep)
+                           : fd_jacobian(system, x, JacobianMethod::ComplexStep);
+        benchmark::DoNotOptimize(jac.data());
+    }
+    state.counters["evaluations"] = static_cast<double>(calls.load());
+}
+BENCHMARK(BM_FdJacobian)->ArgsProduct({{16, 256}, {0, 1}})->ArgNames({"n", "colored"});
+
+}
@@ -0,0 +1,53 @@
+#include "bench_common.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../Integration/composite_simpson.hpp"
+#include "../Integration/romberg.hpp"
+#include "../Integration/simpson.hpp"
+
+namespace {
+
+double integrand(double x) { return std::exp(-x * x) * std::cos(3.0 * x); }
+
+// range(0) is the number of Romberg levels
+void BM_Romberg(benchmark::State& state)
+{
+    const auto levels = static_cast<std::size_t>(state.range(0));
+    numeric::integrate::RombergResult<double> r{};
+    for (auto _ : state) {
+        r = numeric::integrate::integrate_romberg(integrand, 0.0, 2.0, levels);
+        benchmark::DoNotOptimize(r);
+    }
+    state.counters["evaluations"] = static_cast<double>(r.evaluations);
+    state.counters["evals_per_second"] = bench::rate(static_cast<double>(r.evaluations));
+}
+BENCHMARK(BM_Romberg)->DenseRange(4, 16, 4)->ArgName("levels")->Apply(bench::thread_sweep);
+
+void BM_Simpson(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto r = numeric::integrate::integrate_simpson(integrand, 0.0, 2.0);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Simpson);
+
+// Composite Simpson over range(0) subintervals
+void BM_CompositeSimpson(benchmark::State& state)
+{
+    const auto intervals = static_cast<std::size_t>(state.range(0));
+    std::vector<double> x(intervals + 1);
+    for (std::size_t i = 0; i <= intervals; ++i)
+        x[i] = 2.0 * static_cast<double>(i) / static_cast<double>(intervals);
+
+    for (auto _ : state) {
+        auto r = ::integrate_simpson<double>(integrand, x);
+        benchmark::DoNotOptimize(r);
+    }
+    state.counters["evals_per_second"] = bench::rate(static_cast<double>(intervals + 1));
+}
+BENCHMARK(BM_CompositeSimpson)->RangeMultiplier(8)->Range(64, 1 << 18)->Apply(bench::thread_sweep);
+
+}
@@ -0,0 +1,66 @@
+#include "bench_common.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../Solvers/Linear Equation Methods/Gauss-Seidel/gauss_seidel.hpp"
+#include "../Solvers/Linear Equation Methods/Jacobi Method/jacobi_solver.hpp"
+#include "../Solvers/Linear Equation Methods/Successive Over-Relaxation/SOR.hpp"
+
+namespace {
+
+// Strictly diagonally dominant system, so all three iterations converge
+struct System {
+    std::vector<std::vector<double>> A;
+    std::vector<double> b;
+    std::vector<double> x0;
+
+    explicit System(int n) : A(n, std::vector<double>(n)), b(n), x0(n, 0.0)
+    {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j)
+                A[i][j] = i == j ? 2.0 * n : 1.0 / (1.0 + std::abs(i - j));
+            b[i] = std::sin(0.1 * i);
+        }
+    }
+};
+
+void BM_Jacobi(benchmark::State& state)
+{
+    const System sys(static_cast<int>(state.range(0)));
+    bench::QuietCout quiet;
+
+    for (auto _ : state) {
+        auto x = linear_solver::jacobi(sys.A, sys.b, sys.x0, 1e-10, 10'000);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK(BM_Jacobi)->RangeMultiplier(2)->Range(16, 512);
+
+void BM_GaussSeidel(benchmark::State& state)
+{
+    const System sys(static_cast<int>(state.range(0)));
+    bench::QuietCout quiet;
+
+    for (auto _ : state) {
+        auto x = linear_solver::gauss_seidel(sys.A, sys.b, sys.x0, 1e-10, 10'000);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK(BM_GaussSeidel)->RangeMultiplier(2)->Range(16, 512);
+
+// range(1) is omega * 100
+void BM_SOR(benchmark::State& state)
+{
+    const System sys(static_cast<int>(state.range(0)));
+    const double omega = state.range(1) / 100.0;
+
+    for (auto _ : state) {
+        std::vector<double> x = sys.x0;
+        SOR(sys.A, sys.b, x, omega, 10'000, 1e-10);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK(BM_SOR)->ArgsProduct({{16, 64, 256}, {100, 110, 125}})->ArgNames({"n", "omega_x100"});
+
+}
@@ -0,0 +1,168 @@
+#include "bench_common.h"
+
+#include <cmath>
+#include <complex>
+
+#include "../Linear Algebra/Matrix/Matrix.h"
+#include "../Linear Algebra/Matrix/SplitComplexMatrix.h"
+
+namespace {
+
+template <class T>
+Matrix<T> test_matrix(int rows, int cols, int seed = 0)
+{
+    Matrix<T> m(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            const double v = std::sin(0.37 * i + 0.11 * j + seed);
+            if constexpr (matrix_kernels::is_complex_v<T>)
+                m(i, j) = T(v, std::cos(0.23 * i - 0.41 * j + seed));
+            else
+                m(i, j) = T(v);
+        }
+    }
+    return m;
+}
+
+// Symmetric positive definite: diagonally dominant with a symmetric pattern
+Matrix<double> spd_matrix(int n)
+{
+    Matrix<double> m(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j)
+            m(i, j) = 1.0 / (1.0 + std::abs(i - j));
+        m(i, i) += n;
+    }
+    return m;
+}
+
+template <class T>
+void BM_Multiply(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix<T> A = test_matrix<T>(n, n, 1), B = test_matrix<T>(n, n, 2);
+    Matrix<T> C(n, n);
+
+    for (auto _ : state) {
+        Matrix<T>::multiply_into(A, B, C);
+        benchmark::DoNotOptimize(C.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double flops_per_term = matrix_kernels::is_complex_v<T> ? 8.0 : 2.0;
+    state.counters["FLOPS"] = bench::rate(flops_per_term * n * n * n);
+    state.SetBytesProcessed(state.iterations() * 3 * sizeof(T) * int64_t(n) * n);
+}
+BENCHMARK_TEMPLATE(BM_Multiply, float)->RangeMultiplier(2)->Range(32, 512)->Apply(bench::thread_sweep);
+BENCHMARK_TEMPLATE(BM_Multiply, double)->RangeMultiplier(2)->Range(32, 512)->Apply(bench::thread_sweep);
+BENCHMARK_TEMPLATE(BM_Multiply, std::complex<double>)->RangeMultiplier(2)->Range(32, 256);
+
+// Complex product kernels on split storage; range(1) is 0 for 4M, 1 for 3M
+void BM_ComplexSplitMultiply(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const auto kernel = state.range(1) ? matrix_kernels::ComplexKernel::ThreeM
+                                       : matrix_kernels::ComplexKernel::FourM;
+    const SplitComplexMatrix<double> A(test_matrix<std::complex<double>>(n, n, 1));
+    const SplitComplexMatrix<double> B(test_matrix<std::complex<double>>(n, n, 2));
+    SplitComplexMatrix<double> C(n, n);
+
+    for (auto _ : state) {
+        SplitComplexMatrix<double>::multiply_into(A, B, C, kernel);
+        benchmark::DoNotOptimize(C.real().data());
+        benchmark::ClobberMemory();
+    }
+
+    // Rated against the 8 real FLOPs of a classical complex multiply-add
+    state.counters["FLOPS"] = bench::rate(8.0 * n * n * n);
+}
+BENCHMARK(BM_ComplexSplitMultiply)->ArgsProduct({{64, 128, 256}, {0, 1}})->ArgNames({"n", "3m"});
+
+// range(1) is the Strassen recursion cutoff, range(2) the depth of parallel recursion
+void BM_StrassenMultiply(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    matrix_kernels::StrassenOptions options;
+    options.cutoff = static_cast<int>(state.range(1));
+    options.parallel_depth = static_cast<int>(state.range(2));
+    const Matrix<double> A = test_matrix<double>(n, n, 1), B = test_matrix<double>(n, n, 2);
+
+    for (auto _ : state) {
+        Matrix<double> C = Matrix<double>::strassen_multiply(A, B, options);
+        benchmark::DoNotOptimize(C.data());
+    }
+
+    // Effective rate: FLOPs of the classical product
+    state.counters["FLOPS"] = bench::rate(2.0 * n * n * n);
+}
+BENCHMARK(BM_StrassenMultiply)
+    ->ArgsProduct({{256, 512, 1024}, {128, 256}, {0, 1}})
+    ->ArgNames({"n", "cutoff", "parallel_depth"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+void BM_Transpose(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix<double> A = test_matrix<double>(n, n);
+
+    for (auto _ : state) {
+        Matrix<double> At = A.transpose();
+        benchmark::DoNotOptimize(At.data());
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * sizeof(double) * int64_t(n) * n);
+}
+BENCHMARK(BM_Transpose)->RangeMultiplier(4)->Range(64, 1024)->Apply(bench::thread_sweep);
+
+void BM_Expm(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix<double> A = test_matrix<double>(n, n);
+
+    for (auto _ : state) {
+        Matrix<double> E = A.expm();
+        benchmark::DoNotOptimize(E.data());
+    }
+}
+BENCHMARK(BM_Expm)->RangeMultiplier(2)->Range(16, 128);
+
+void BM_QR(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix<double> A = test_matrix<double>(n, n);
+    Matrix<double> Q(n, n), R(n, n);
+
+    for (auto _ : state) {
+        A.QRDecomposition(Q, R);
+        benchmark::DoNotOptimize(R.data());
+    }
+    state.counters["FLOPS"] = bench::rate(10.0 / 3.0 * n * n * n);
+}
+BENCHMARK(BM_QR)->RangeMultiplier(2)->Range(16, 256);
+
+void BM_Cholesky(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix<double> A = spd_matrix(n);
+
+    for (auto _ : state) {
+        Matrix<double> L = A.CholeskyDecomposition();
+        benchmark::DoNotOptimize(L.data());
+    }
+    state.counters["FLOPS"] = bench::rate(n * double(n) * n / 3.0);
+}
+BENCHMARK(BM_Cholesky)->RangeMultiplier(2)->Range(16, 256);
+
+void BM_HermitianEigenvalues(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix<double> A = spd_matrix(n);
+
+    for (auto _ : state) {
+        auto lambda = A.hermitian_eigenvalues();
+        benchmark::DoNotOptimize(lambda.data());
+    }
+}
+BENCHMARK(BM_HermitianEigenvalues)->RangeMultiplier(2)->Range(8, 64);
+
+}
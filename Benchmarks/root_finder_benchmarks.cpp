@@ -0,0 +1,229 @@
+#include "bench_common.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../Solvers/Non Linear Equations/Bisection/bisection.hpp"
+#include "../Solvers/Non Linear Equations/Brent/brent.hpp"
+#include "../Solvers/Non Linear Equations/Broyden/broyden.hpp"
+#include "../Solvers/Non Linear Equations/Newton-Krylov/newton_krylov.hpp"
+#include "../Solvers/Non Linear Equations/Newton-Raphson/newton_raphson.hpp"
+#include "../Solvers/Non Linear Equations/Regula-Falsi/regula_falsi.hpp"
+#include "../Solvers/Non Linear Equations/Secant Method/secant_method.hpp"
+
+namespace {
+
+// Test functions with a simple root in [a, b]; range(0) picks one
+struct Problem {
+    double (*f)(double);
+    double a, b;
+};
+
+const Problem problems[] = {
+    {[](double x) { return x * x * x - 2.0 * x - 5.0; }, 2.0, 3.0},
+    {[](double x) { return std::cos(x) - x; }, 0.0, 1.0},
+    {[](double x) { return std::exp(x) - 10.0; }, 0.0, 5.0},
+    {[](double x) { return std::pow(x, 10.0) - 1.0; }, 0.0, 1.3},      // stalls classic regula falsi
+};
+
+// Every scalar solver runs with the same stopping rule: bisection only
+// honours tol_abs, so the relative tolerance is off for all of them
+nonlinear_solver::SolverOptions absolute_tolerance()
+{
+    nonlinear_solver::SolverOptions opt;
+    opt.tol_rel = 0.0;
+    return opt;
+}
+
+// Function evaluations are the real cost for expensive f; iterations
+// are not comparable across methods
+void report(benchmark::State& state, const std::optional<nonlinear_solver::SolverResult>& r)
+{
+    state.counters["evaluations"] = r ? r->evaluations : -1;
+    state.counters["iterations"] = r ? r->iterations : -1;
+    state.counters["converged"] = r && r->converged;
+}
+
+void BM_Bisection(benchmark::State& state)
+{
+    const Problem& p = problems[state.range(0)];
+    std::optional<nonlinear_solver::SolverResult> r;
+    for (auto _ : state) {
+        r = nonlinear_solver::bisection(p.f, p.a, p.b, absolute_tolerance());
+        benchmark::DoNotOptimize(r);
+    }
+    report(state, r);
+}
+BENCHMARK(BM_Bisection)->DenseRange(0, 3)->ArgName("problem");
+
+void BM_RegulaFalsi(benchmark::State& state)
+{
+    const Problem& p = problems[state.range(0)];
+    std::optional<nonlinear_solver::SolverResult> r;
+    for (auto _ : state) {
+        r = nonlinear_solver::regula_falsi(p.f, p.a, p.b, absolute_tolerance());
+        benchmark::DoNotOptimize(r);
+    }
+    report(state, r);
+}
+BENCHMARK(BM_RegulaFalsi)->DenseRange(0, 3)->ArgName("problem");
+
+void BM_Secant(benchmark::State& state)
+{
+    const Problem& p = problems[state.range(0)];
+    std::optional<nonlinear_solver::SolverResult> r;
+    for (auto _ : state) {
+        r = nonlinear_solver::secant(p.f, p.a, p.b, absolute_tolerance());
+        benchmark::DoNotOptimize(r);
+    }
+    report(state, r);
+}
+BENCHMARK(BM_Secant)->DenseRange(0, 3)->ArgName("problem");
+
+// range(1): 0 Illinois, 1 Anderson-Bjorck
+void BM_ModifiedRegulaFalsi(benchmark::State& state)
+{
+    const Problem& p = problems[state.range(0)];
+    const auto variant = state.range(1) == 0 ? nonlinear_solver::FalsiVariant::Illinois
+                                             : nonlinear_solver::FalsiVariant::AndersonBjorck;
+    std::optional<nonlinear_solver::SolverResult> r;
+    for (auto _ : state) {
+        r = nonlinear_solver::regula_falsi(p.f, p.a, p.b, absolute_tolerance(), variant);
+        benchmark::DoNotOptimize(r);
+    }
+    report(state, r);
+}
+BENCHMARK(BM_ModifiedRegulaFalsi)->ArgsProduct({{0, 1, 2, 3}, {0, 1}})->ArgNames({"problem", "variant"});
+
+void BM_Brent(benchmark::State& state)
+{
+    const Problem& p = problems[state.range(0)];
+    std::optional<nonlinear_solver::SolverResult> r;
+    for (auto _ : state) {
+        r = nonlinear_solver::brent(p.f, p.a, p.b, absolute_tolerance());
+        benchmark::DoNotOptimize(r);
+    }
+    report(state, r);
+}
+BENCHMARK(BM_Brent)->DenseRange(0, 3)->ArgName("problem");
+
+void BM_Toms748(benchmark::State& state)
+{
+    const Problem& p = problems[state.range(0)];
+    std::optional<nonlinear_solver::SolverResult> r;
+    for (auto _ : state) {
+        r = nonlinear_solver::toms748(p.f, p.a, p.b, absolute_tolerance());
+        benchmark::DoNotOptimize(r);
+    }
+    report(state, r);
+}
+BENCHMARK(BM_Toms748)->DenseRange(0, 3)->ArgName("problem");
+
+// Broyden's tridiagonal system of range(0) equations with an analytic
+// Jacobian; range(1) is NewtonOptions::jacobian_refresh (0 = chord)
+void BM_NewtonSystem(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    auto F = [n](const std::vector<double>& x) {
+        std::vector<double> r(n);
+        for (int i = 0; i < n; ++i) {
+            r[i] = (3.0 - 2.0 * x[i]) * x[i] + 1.0;
+            if (i > 0) r[i] -= x[i - 1];
+            if (i + 1 < n) r[i] -= 2.0 * x[i + 1];
+        }
+        return r;
+    };
+    auto J = [n](const std::vector<double>& x) {
+        std::vector<std::vector<double>> jac(n, std::vector<double>(n, 0.0));
+        for (int i = 0; i < n; ++i) {
+            jac[i][i] = 3.0 - 4.0 * x[i];
+            if (i > 0) jac[i][i - 1] = -1.0;
+            if (i + 1 < n) jac[i][i + 1] = -2.0;
+        }
+        return jac;
+    };
+    NewtonOptions opt;
+    opt.tol = 1e-10;
+    opt.jacobian_refresh = static_cast<int>(state.range(1));
+    const std::vector<double> x0(n, -1.0);
+    NewtonResult<std::vector<double>> r{};
+    for (auto _ : state) {
+        r = newton_raphson(F, J, x0, opt);
+        benchmark::DoNotOptimize(r.solution.data());
+    }
+    state.counters["iterations"] = r.iterations;
+    state.counters["factorizations"] = r.factorizations;
+    state.counters["converged"] = r.converged;
+}
+BENCHMARK(BM_NewtonSystem)->ArgsProduct({{100, 400}, {1, 3, 0}})->ArgNames({"n", "refresh"})
+    ->Unit(benchmark::kMillisecond);
+
+// Difference-Jacobian Newton against Broyden on the same tridiagonal
+// system; range(0) = 0 Newton, 1 good Broyden, 2 bad Broyden. The
+// evaluations counter is what matters for expensive residuals.
+void BM_QuasiNewton(benchmark::State& state)
+{
+    const int n = 100;
+    auto F = [n](const std::vector<double>& x) {
+        std::vector<double> r(n);
+        for (int i = 0; i < n; ++i) {
+            r[i] = (3.0 - 2.0 * x[i]) * x[i] + 1.0;
+            if (i > 0) r[i] -= x[i - 1];
+            if (i + 1 < n) r[i] -= 2.0 * x[i + 1];
+        }
+        return r;
+    };
+    const std::vector<double> x0(n, -1.0);
+    NewtonResult<std::vector<double>> r{};
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            NewtonOptions opt;
+            opt.tol = 1e-10;
+            r = newton_raphson(F, x0, opt);
+        } else {
+            BroydenOptions opt;
+            opt.tol = 1e-10;
+            opt.update = state.range(0) == 1 ? BroydenUpdate::Good : BroydenUpdate::Bad;
+            r = broyden(F, x0, opt);
+        }
+        benchmark::DoNotOptimize(r.solution.data());
+    }
+    state.counters["evaluations"] = r.evaluations;
+    state.counters["iterations"] = r.iterations;
+    state.counters["converged"] = r.converged;
+}
+BENCHMARK(BM_QuasiNewton)->DenseRange(0, 2)->ArgName("method")->Unit(benchmark::kMillisecond);
+
+// Jacobian-free Newton-Krylov on u + (4u - neighbours) + u^3 = 1 over a
+// range(0) x range(0) grid; memory and work stay linear in the unknowns
+void BM_NewtonKrylov(benchmark::State& state)
+{
+    const int m = static_cast<int>(state.range(0));
+    auto F = [m](const std::vector<double>& u) {
+        std::vector<double> r(u.size());
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < m; ++j) {
+                const int k = i * m + j;
+                double s = 5.0 * u[k] + u[k] * u[k] * u[k] - 1.0;
+                if (i > 0) s -= u[k - m];
+                if (i + 1 < m) s -= u[k + m];
+                if (j > 0) s -= u[k - 1];
+                if (j + 1 < m) s -= u[k + 1];
+                r[k] = s;
+            }
+        }
+        return r;
+    };
+    const std::vector<double> x0(static_cast<std::size_t>(m) * m, 0.0);
+    nonlinear_solver::SystemSolverResult r;
+    for (auto _ : state) {
+        r = nonlinear_solver::newton_krylov(F, x0);
+        benchmark::DoNotOptimize(r.root.data());
+    }
+    state.counters["evaluations"] = r.evaluations;
+    state.counters["gmres"] = r.linear_iterations;
+    state.counters["converged"] = r.converged;
+}
+BENCHMARK(BM_NewtonKrylov)->RangeMultiplier(2)->Range(64, 512)->ArgName("grid")->Unit(benchmark::kMillisecond);
+
+}
@@ -0,0 +1,40 @@
+#include "bench_common.h"
+
+#include <vector>
+
+#include "../Special-Functions/bessel.hpp"
+#include "../Special-Functions/elliptic.hpp"
+#include "../Special-Functions/gamma.hpp"
+#include "../Special-Functions/zeta.hpp"
+
+namespace {
+
+// Evaluates fn at range(0) points spread over [lo, hi]
+template <class T>
+void BM_Special(benchmark::State& state, T (*fn)(T), double lo, double hi)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<T> x(n), y(n);
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = static_cast<T>(lo + (hi - lo) * (i + 0.5) / n);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i)
+            y[i] = fn(x[i]);
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+BENCHMARK_CAPTURE(BM_Special, gamma, &special_functions::gamma<double>, 0.1, 20.0)
+    ->Arg(4096)->Apply(bench::thread_sweep);
+BENCHMARK_CAPTURE(BM_Special, gamma_float, &special_functions::gamma<float>, 0.1, 20.0)
+    ->Arg(4096);
+BENCHMARK_CAPTURE(BM_Special, bessel_j0, &special_functions::bessel_j0<double>, 0.0, 50.0)
+    ->Arg(4096)->Apply(bench::thread_sweep);
+BENCHMARK_CAPTURE(BM_Special, elliptic_k, &special_functions::elliptic_k<double>, 0.0, 0.99)
+    ->Arg(4096)->Apply(bench::thread_sweep);
+BENCHMARK_CAPTURE(BM_Special, riemann_zeta, &special_functions::riemann_zeta<double>, 1.5, 10.0)
+    ->Arg(1024)->Apply(bench::thread_sweep);
+
+}
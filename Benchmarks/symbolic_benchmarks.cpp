@@ -0,0 +1,56 @@
+#include "bench_common.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../Differentiation/Symbolic Differentiation/symbolic_diff.h"
+#include "../Differentiation/Symbolic Differentiation/symbolic_eval.h"
+
+namespace {
+
+using namespace symbolic;
+
+// f(x, y) = sin(x y) cos(x) + 3 x^2 with both partial derivatives
+CompiledExpression gradient_program()
+{
+    auto x = make_variable("x");
+    auto y = make_variable("y");
+    auto f = sin(x * y) * cos(x) + make_constant(3.0) * x * x;
+    return CompiledExpression({f, f->derivative("x")->simplify(), f->derivative("y")->simplify()}, {"x", "y"});
+}
+
+// One point at a time
+void BM_CompiledEvaluate(benchmark::State& state)
+{
+    const CompiledExpression program = gradient_program();
+    double point[2] = {0.3, 0.9}, out[3];
+
+    for (auto _ : state) {
+        program.evaluate(point, out);
+        benchmark::DoNotOptimize(out);
+        point[0] += 1e-9;
+    }
+    state.counters["points_per_second"] = bench::rate(1.0);
+}
+BENCHMARK(BM_CompiledEvaluate);
+
+// A grid of points in blocks
+void BM_CompiledEvaluateBatch(benchmark::State& state)
+{
+    const CompiledExpression program = gradient_program();
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<double> grid(2 * count), out(3 * count);
+    for (std::size_t p = 0; p < count; ++p) {
+        grid[p] = -2.0 + 4.0 * p / count;
+        grid[count + p] = std::cos(0.01 * p);
+    }
+
+    for (auto _ : state) {
+        program.evaluate_batch(grid.data(), count, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["points_per_second"] = bench::rate(double(count));
+}
+BENCHMARK(BM_CompiledEvaluateBatch)->RangeMultiplier(16)->Range(256, 1 << 20);
+
+}
@@ -1,10 +1,42 @@
 #include "autodiff.h"
 
+#include <cmath>
+
+// Evaluation passes
+
+template <typename T>
+value_and_partial<T> expression<T>::evaluate_and_derive(variable<T>* var) {
+    if (evaluation_pass::active) {
+        return visit(this, var);   // called from inside a pass: join it
+    }
+
+    struct pass_guard {
+        pass_guard() {
+            evaluation_pass::epoch = evaluation_pass::next_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+            evaluation_pass::visited = 0;
+            evaluation_pass::active = true;
+        }
+        ~pass_guard() { evaluation_pass::active = false; }
+    } guard;
+
+    return visit(this, var);
+}
+
+template <typename T>
+value_and_partial<T> expression<T>::visit(expression<T>* operand, variable<T>* var) {
+    if (operand->epoch != evaluation_pass::epoch) {
+        operand->cached = operand->compute(var);
+        operand->epoch = evaluation_pass::epoch;
+        ++evaluation_pass::visited;
+    }
+    return operand->cached;
+}
+
 template <typename T>
 variable<T>::variable(T value) : value(value) {}
 
 template <typename T>
-value_and_partial<T> variable<T>::evaluate_and_derive(variable<T>* var) {
+value_and_partial<T> variable<T>::compute(variable<T>* var) {
     T partial = (this == var) ? static_cast<T>(1) : static_cast<T>(0);
     return { value, partial };
 }
@@ -19,11 +51,11 @@ plus<T, Ops...>::plus(Ops... ops) : operands(ops...) {
 }
 
 template <typename T, typename... Ops>
-value_and_partial<T> plus<T, Ops...>::evaluate_and_derive(variable<T>* var) {
+value_and_partial<T> plus<T, Ops...>::compute(variable<T>* var) {
     value_and_partial<T> result{ static_cast<T>(0), static_cast<T>(0) };
     std::apply([&](auto... ops) {
         (([&] {
-            auto temp = ops->evaluate_and_derive(var);
+            auto temp = this->visit(ops, var);
             result.value += temp.value;
             result.partial += temp.partial;
         }()), ...);
@@ -41,12 +73,12 @@ multiply<T, Ops...>::multiply(Ops... ops) : operands(ops...) {
 }
 
 template <typename T, typename... Ops>
-value_and_partial<T> multiply<T, Ops...>::evaluate_and_derive(variable<T>* var) {
+value_and_partial<T> multiply<T, Ops...>::compute(variable<T>* var) {
     constexpr std::size_t n = sizeof...(Ops);
 
     // Evaluate every operand exactly once
     auto evals = std::apply([&](auto*... ops) -> std::array<value_and_partial<T>, n> {
-        return { ops->evaluate_and_derive(var)... };
+        return { this->visit(ops, var)... };
     }, operands);
 
     // Product of all operand values.
@@ -76,8 +108,9 @@ struct sin_op : unary_op<T> {
 
     sin_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         return {
             std::sin(ev.value),
             std::cos(ev.value) * ev.partial
@@ -90,8 +123,9 @@ struct asin_op : unary_op<T> {
     using unary_op<T>::operand;
     asin_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         T value = std::asin(ev.value);
         T deriv = ev.partial / std::sqrt(1 - ev.value * ev.value);
         return { value, deriv };
@@ -105,8 +139,9 @@ struct cos_op : unary_op<T> {
 
     cos_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         return {
             std::cos(ev.value),
             -std::sin(ev.value) * ev.partial
@@ -119,8 +154,9 @@ struct acos_op : unary_op<T> {
     using unary_op<T>::operand;
     acos_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         T value = std::acos(ev.value);
         T deriv = -ev.partial / std::sqrt(1 - ev.value * ev.value);
         return { value, deriv };
@@ -132,8 +168,9 @@ struct tan_op : unary_op<T> {
     using unary_op<T>::operand;
     tan_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         T value = std::tan(ev.value);
         T deriv = (1 / std::cos(ev.value)) * (1 / std::cos(ev.value)) * ev.partial; // sec^2(x)
         return { value, deriv };
@@ -145,8 +182,9 @@ struct cot_op : unary_op<T> {
     using unary_op<T>::operand;
     cot_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         T value = static_cast<T>(1) / std::tan(ev.value);
         T deriv = -static_cast<T>(1) / (std::sin(ev.value) * std::sin(ev.value)) * ev.partial; // -csc^2(x)
         return { value, deriv };
@@ -158,8 +196,9 @@ struct sec_op : unary_op<T> {
     using unary_op<T>::operand;
     sec_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         T secx = static_cast<T>(1) / std::cos(ev.value);
         T deriv = secx * std::tan(ev.value) * ev.partial;
         return { secx, deriv };
@@ -173,8 +212,9 @@ struct exp_op : unary_op<T> {
 
     exp_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         T e = std::exp(ev.value);
         return { e, e * ev.partial };
     }
@@ -186,8 +226,9 @@ struct log_op : unary_op<T> {
 
     log_op(expression<T>* op) : unary_op<T>(op) {}
 
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override {
-        auto ev = operand->evaluate_and_derive(var);
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override {
+        auto ev = this->visit(operand, var);
         return {
             std::log(ev.value),
             (static_cast<T>(1) / ev.value) * ev.partial
@@ -196,6 +237,9 @@ struct log_op : unary_op<T> {
 };
 
 
+template struct expression<float>;
+template struct expression<double>;
+
 template struct variable<float>;
 template struct variable<double>;
 
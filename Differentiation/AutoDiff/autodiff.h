@@ -2,7 +2,9 @@
 
 #include <tuple>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -21,31 +23,68 @@ struct value_and_partial {
 template <typename T>
 struct variable;
 
+// Bookkeeping of the evaluation pass running on this thread. Every call of
+// evaluate_and_derive on a root is one pass with a fresh epoch; nodes
+// remember the epoch of their cached result, so a node shared by several
+// parents is computed once per pass however many paths lead to it.
+// Epochs come from one global counter, so a graph may be evaluated by
+// different threads in turn (but not by two threads at once).
+struct evaluation_pass {
+    inline static std::atomic<std::uint64_t> next_epoch{0};
+    inline static thread_local std::uint64_t epoch = 0;
+    inline static thread_local bool active = false;
+    inline static thread_local std::size_t visited = 0;
+
+    // Nodes computed (not read from cache) by the last pass on this thread
+    static std::size_t last_nodes_visited() { return visited; }
+};
+
 template <typename T>
 struct expression {
     virtual ~expression() = default;
-    virtual value_and_partial<T> evaluate_and_derive(variable<T>* var) = 0;
+
+    // Value of the graph rooted here and its partial derivative with
+    // respect to var (nullptr: value only). Each node is computed at most
+    // once per call.
+    value_and_partial<T> evaluate_and_derive(variable<T>* var);
+
+    protected:
+    // Value of an operand within the pass in progress
+    static value_and_partial<T> visit(expression<T>* operand, variable<T>* var);
+
+    // Computes this node from its operands, which it reads with visit()
+    virtual value_and_partial<T> compute(variable<T>* var) = 0;
+
+    private:
+    std::uint64_t epoch = 0;
+    value_and_partial<T> cached{};
 };
 
 template <typename T>
 struct variable : public expression<T> {
     T value;
     explicit variable(T value);
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override;
+
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override;
 };
 
 template <typename T, typename... Ops>
 struct plus : public expression<T> {
     std::tuple<Ops...> operands;
     explicit plus(Ops... ops);
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override;
+
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override;
 };
 
 template <typename T, typename... Ops>
 struct multiply : public expression<T> {
     std::tuple<Ops...> operands;
     explicit multiply(Ops... ops);
-    value_and_partial<T> evaluate_and_derive(variable<T>* var) override;
+
+    protected:
+    value_and_partial<T> compute(variable<T>* var) override;
 };
 
 template <typename T>
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Forward-mode automatic differentiation with N tangent lanes.
+//
+// dual<T, N> carries a value and N directional derivatives. Arithmetic
+// updates all lanes together in fixed-length loops that the compiler
+// unrolls and vectorizes (the lanes are aligned as one SIMD block when N
+// is a power of two), so one pass of a plain C++ function yields N columns
+// of its Jacobian:
+//
+//     auto f = [](auto x, auto y) { return x * sin(y); };
+//     autodiff::dual<double, 2> x(1.0, 0), y(0.5, 1);   // seeds lanes 0 and 1
+//     auto r = f(x, y);     // r.value, r.tangent[0] = df/dx, r.tangent[1] = df/dy
+//
+// Functions written as templates (or with auto parameters) work unchanged;
+// elementary functions are found by argument-dependent lookup.
+namespace autodiff {
+
+namespace detail {
+
+// Alignment of a block of N lanes: the whole block for power-of-two sizes
+// up to 64 bytes, so a lane loop maps onto full SIMD registers
+template <typename T, int N>
+constexpr std::size_t lane_alignment() {
+    constexpr std::size_t bytes = sizeof(T) * static_cast<std::size_t>(N);
+    if constexpr ((bytes & (bytes - 1)) == 0 && bytes <= 64 && bytes >= alignof(T)) {
+        return bytes;
+    } else {
+        return alignof(T);
+    }
+}
+
+}
+
+template <typename T, int N>
+struct dual {
+    static_assert(N >= 1, "dual needs at least one tangent lane");
+
+    T value{};
+    alignas(detail::lane_alignment<T, N>()) T tangent[N] = {};
+
+    dual() = default;
+
+    // A constant: all tangent lanes are zero
+    dual(T constant) : value(constant) {}
+
+    // An independent variable seeded in one lane
+    dual(T v, int lane) : value(v) {
+        if (lane < 0 || lane >= N) {
+            throw std::out_of_range("dual lane out of range");
+        }
+        tangent[lane] = T(1);
+    }
+
+    static constexpr int lanes = N;
+
+    dual& operator+=(const dual& b) {
+        value += b.value;
+        for (int i = 0; i < N; ++i) tangent[i] += b.tangent[i];
+        return *this;
+    }
+
+    dual& operator-=(const dual& b) {
+        value -= b.value;
+        for (int i = 0; i < N; ++i) tangent[i] -= b.tangent[i];
+        return *this;
+    }
+
+    dual& operator*=(const dual& b) {
+        for (int i = 0; i < N; ++i) tangent[i] = tangent[i] * b.value + value * b.tangent[i];
+        value *= b.value;
+        return *this;
+    }
+
+    dual& operator/=(const dual& b) {
+        const T inv = T(1) / b.value;
+        value *= inv;
+        for (int i = 0; i < N; ++i) tangent[i] = (tangent[i] - value * b.tangent[i]) * inv;
+        return *this;
+    }
+};
+
+namespace detail {
+
+// Result with value f and every lane scaled by the local derivative df
+template <typename T, int N>
+dual<T, N> chain(const dual<T, N>& a, T f, T df) {
+    dual<T, N> r(f);
+    for (int i = 0; i < N; ++i) r.tangent[i] = df * a.tangent[i];
+    return r;
+}
+
+}
+
+template <typename T, int N>
+using dual_scalar = std::type_identity_t<T>;
+
+// Arithmetic
+
+template <typename T, int N>
+dual<T, N> operator+(dual<T, N> a, const dual<T, N>& b) { return a += b; }
+template <typename T, int N>
+dual<T, N> operator-(dual<T, N> a, const dual<T, N>& b) { return a -= b; }
+template <typename T, int N>
+dual<T, N> operator*(dual<T, N> a, const dual<T, N>& b) { return a *= b; }
+template <typename T, int N>
+dual<T, N> operator/(dual<T, N> a, const dual<T, N>& b) { return a /= b; }
+
+template <typename T, int N>
+dual<T, N> operator-(const dual<T, N>& a) { return detail::chain(a, -a.value, T(-1)); }
+template <typename T, int N>
+dual<T, N> operator+(const dual<T, N>& a) { return a; }
+
+template <typename T, int N>
+dual<T, N> operator+(dual<T, N> a, dual_scalar<T, N> s) { a.value += s; return a; }
+template <typename T, int N>
+dual<T, N> operator+(dual_scalar<T, N> s, dual<T, N> a) { a.value += s; return a; }
+template <typename T, int N>
+dual<T, N> operator-(dual<T, N> a, dual_scalar<T, N> s) { a.value -= s; return a; }
+template <typename T, int N>
+dual<T, N> operator-(dual_scalar<T, N> s, const dual<T, N>& a) { return detail::chain(a, s - a.value, T(-1)); }
+template <typename T, int N>
+dual<T, N> operator*(const dual<T, N>& a, dual_scalar<T, N> s) { return detail::chain(a, a.value * s, s); }
+template <typename T, int N>
+dual<T, N> operator*(dual_scalar<T, N> s, const dual<T, N>& a) { return detail::chain(a, s * a.value, s); }
+template <typename T, int N>
+dual<T, N> operator/(const dual<T, N>& a, dual_scalar<T, N> s) {
+    const T inv = T(1) / s;
+    return detail::chain(a, a.value * inv, inv);
+}
+template <typename T, int N>
+dual<T, N> operator/(dual_scalar<T, N> s, const dual<T, N>& a) {
+    const T inv = T(1) / a.value;
+    const T q = s * inv;
+    return detail::chain(a, q, -q * inv);
+}
+
+// Comparisons look at values only
+
+template <typename T, int N>
+bool operator==(const dual<T, N>& a, const dual<T, N>& b) { return a.value == b.value; }
+template <typename T, int N>
+bool operator!=(const dual<T, N>& a, const dual<T, N>& b) { return a.value != b.value; }
+template <typename T, int N>
+bool operator<(const dual<T, N>& a, const dual<T, N>& b) { return a.value < b.value; }
+template <typename T, int N>
+bool operator>(const dual<T, N>& a, const dual<T, N>& b) { return a.value > b.value; }
+template <typename T, int N>
+bool operator<=(const dual<T, N>& a, const dual<T, N>& b) { return a.value <= b.value; }
+template <typename T, int N>
+bool operator>=(const dual<T, N>& a, const dual<T, N>& b) { return a.value >= b.value; }
+
+// Elementary functions
+
+template <typename T, int N>
+dual<T, N> sin(const dual<T, N>& a) {
+    using std::sin; using std::cos;
+    return detail::chain(a, sin(a.value), cos(a.value));
+}
+
+template <typename T, int N>
+dual<T, N> cos(const dual<T, N>& a) {
+    using std::sin; using std::cos;
+    return detail::chain(a, cos(a.value), -sin(a.value));
+}
+
+template <typename T, int N>
+dual<T, N> tan(const dual<T, N>& a) {
+    using std::tan;
+    const T t = tan(a.value);
+    return detail::chain(a, t, T(1) + t * t);
+}
+
+template <typename T, int N>
+dual<T, N> asin(const dual<T, N>& a) {
+    using std::asin; using std::sqrt;
+    return detail::chain(a, asin(a.value), T(1) / sqrt(T(1) - a.value * a.value));
+}
+
+template <typename T, int N>
+dual<T, N> acos(const dual<T, N>& a) {
+    using std::acos; using std::sqrt;
+    return detail::chain(a, acos(a.value), T(-1) / sqrt(T(1) - a.value * a.value));
+}
+
+template <typename T, int N>
+dual<T, N> atan(const dual<T, N>& a) {
+    using std::atan;
+    return detail::chain(a, atan(a.value), T(1) / (T(1) + a.value * a.value));
+}
+
+template <typename T, int N>
+dual<T, N> sinh(const dual<T, N>& a) {
+    using std::sinh; using std::cosh;
+    return detail::chain(a, sinh(a.value), cosh(a.value));
+}
+
+template <typename T, int N>
+dual<T, N> cosh(const dual<T, N>& a) {
+    using std::sinh; using std::cosh;
+    return detail::chain(a, cosh(a.value), sinh(a.value));
+}
+
+template <typename T, int N>
+dual<T, N> tanh(const dual<T, N>& a) {
+    using std::tanh;
+    const T t = tanh(a.value);
+    return detail::chain(a, t, T(1) - t * t);
+}
+
+template <typename T, int N>
+dual<T, N> exp(const dual<T, N>& a) {
+    using std::exp;
+    const T e = exp(a.value);
+    return detail::chain(a, e, e);
+}
+
+template <typename T, int N>
+dual<T, N> log(const dual<T, N>& a) {
+    using std::log;
+    return detail::chain(a, log(a.value), T(1) / a.value);
+}
+
+template <typename T, int N>
+dual<T, N> sqrt(const dual<T, N>& a) {
+    using std::sqrt;
+    const T r = sqrt(a.value);
+    return detail::chain(a, r, T(1) / (T(2) * r));
+}
+
+template <typename T, int N>
+dual<T, N> abs(const dual<T, N>& a) {
+    return a.value < T(0) ? -a : a;
+}
+
+template <typename T, int N>
+dual<T, N> pow(const dual<T, N>& a, dual_scalar<T, N> p) {
+    using std::pow;
+    return detail::chain(a, pow(a.value, p), p * pow(a.value, p - T(1)));
+}
+
+template <typename T, int N>
+dual<T, N> pow(const dual<T, N>& a, const dual<T, N>& b) {
+    using std::pow; using std::log;
+    const T v = pow(a.value, b.value);
+    const T da = b.value * pow(a.value, b.value - T(1));
+    const T db = v * log(a.value);
+    dual<T, N> r(v);
+    for (int i = 0; i < N; ++i) r.tangent[i] = da * a.tangent[i] + db * b.tangent[i];
+    return r;
+}
+
+template <typename T, int N>
+dual<T, N> pow(dual_scalar<T, N> s, const dual<T, N>& b) {
+    using std::pow; using std::log;
+    const T v = pow(s, b.value);
+    return detail::chain(b, v, v * log(s));
+}
+
+// Jacobian of f: R^n -> R^m at x, where f maps std::vector<dual<T, N>> to
+// std::vector<dual<T, N>>. Columns are seeded N at a time, so the cost is
+// ceil(n / N) evaluations of f. Returns the m x n Jacobian by rows.
+template <int N, typename T, typename F>
+std::vector<std::vector<T>> jacobian(F&& f, const std::vector<T>& x) {
+    const int n = static_cast<int>(x.size());
+    std::vector<std::vector<T>> jac;
+    std::vector<dual<T, N>> args(x.begin(), x.end());
+
+    for (int first = 0; first < n; first += N) {
+        const int width = n - first < N ? n - first : N;
+        for (int j = 0; j < width; ++j) args[first + j].tangent[j] = T(1);
+
+        const std::vector<dual<T, N>> y = f(args);
+        if (jac.empty()) {
+            jac.assign(y.size(), std::vector<T>(n));
+        }
+        for (std::size_t i = 0; i < y.size(); ++i) {
+            for (int j = 0; j < width; ++j) jac[i][first + j] = y[i].tangent[j];
+        }
+
+        for (int j = 0; j < width; ++j) args[first + j].tangent[j] = T(0);
+    }
+    return jac;
+}
+
+// Gradient of a scalar f: R^n -> R in ceil(n / N) forward passes
+template <int N, typename T, typename F>
+std::vector<T> gradient(F&& f, const std::vector<T>& x) {
+    const int n = static_cast<int>(x.size());
+    std::vector<T> grad(n);
+    std::vector<dual<T, N>> args(x.begin(), x.end());
+
+    for (int first = 0; first < n; first += N) {
+        const int width = n - first < N ? n - first : N;
+        for (int j = 0; j < width; ++j) args[first + j].tangent[j] = T(1);
+        const dual<T, N> y = f(args);
+        for (int j = 0; j < width; ++j) grad[first + j] = y.tangent[j];
+        for (int j = 0; j < width; ++j) args[first + j].tangent[j] = T(0);
+    }
+    return grad;
+}
+
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Flat, index-linked expression graph.
+//
+// The pool stores nodes as parallel arrays (opcode, operand indices,
+// payload) in the order they are created. Operands always exist before
+// the node using them, so creation order is a topological order and
+// evaluation is a single loop over the arrays: no virtual calls, no
+// pointer chasing, and all nodes of a graph in a few contiguous blocks.
+// Building a node appends to the arrays, which act as an arena; release()
+// drops the whole graph at once and keeps the capacity for the next one.
+//
+//     autodiff::expression_pool<double> pool;
+//     auto x = pool.variable(1.0), y = pool.variable(2.0);
+//     auto f = x * y + sin(x);
+//     double v = pool.evaluate(f);
+//     std::vector<double> g;
+//     pool.value_and_gradient(f, g);        // one forward, one reverse loop
+//
+// Handles hold indices, not pointers, so they stay valid while the pool
+// grows, until release().
+namespace autodiff {
+
+enum class opcode : std::uint8_t {
+    variable, constant,
+    add, sub, mul, div, neg,
+    sin, cos, tan, exp, log, sqrt, tanh,
+    pow_const   // operand raised to the constant in payload
+};
+
+template <typename T>
+class expression_pool;
+
+template <typename T>
+struct pool_node {
+    expression_pool<T>* pool = nullptr;
+    std::uint32_t index = 0;
+};
+
+template <typename T>
+class expression_pool {
+    public:
+    using index_type = std::uint32_t;
+    using node = pool_node<T>;
+
+    // Independent variable k (in creation order) with an initial value
+    node variable(T value) {
+        const node n = push(opcode::variable, 0, 0, value);
+        inputs.push_back(n.index);
+        return n;
+    }
+
+    node constant(T value) { return push(opcode::constant, 0, 0, value); }
+
+    node unary(opcode op, node a, T parameter = T(0)) {
+        check(a);
+        return push(op, a.index, a.index, parameter);
+    }
+
+    node binary(opcode op, node a, node b) {
+        check(a);
+        check(b);
+        return push(op, a.index, b.index, T(0));
+    }
+
+    // Value of variable k for the next evaluation
+    void set_variable(std::size_t k, T value) { payload[inputs.at(k)] = value; }
+    T get_variable(std::size_t k) const { return payload[inputs.at(k)]; }
+    std::size_t num_variables() const { return inputs.size(); }
+    std::size_t size() const { return ops.size(); }
+
+    T evaluate(node root) {
+        check(root);
+        forward(root.index);
+        return values[root.index];
+    }
+
+    // Value and derivative with respect to one variable, the same result
+    // as expression<T>::evaluate_and_derive, in one forward loop
+    T value_and_partial(node root, node var, T& partial) {
+        check(root);
+        check(var);
+        forward(root.index);
+        tangents.assign(root.index + 1, T(0));
+        if (var.index <= root.index) tangents[var.index] = T(1);
+        for (index_type i = 0; i <= root.index; ++i) {
+            const index_type a = lhs[i], b = rhs[i];
+            switch (ops[i]) {
+                case opcode::variable:
+                case opcode::constant: break;
+                case opcode::add: tangents[i] = tangents[a] + tangents[b]; break;
+                case opcode::sub: tangents[i] = tangents[a] - tangents[b]; break;
+                case opcode::mul: tangents[i] = tangents[a] * values[b] + values[a] * tangents[b]; break;
+                case opcode::div: tangents[i] = (tangents[a] - values[i] * tangents[b]) / values[b]; break;
+                case opcode::neg: tangents[i] = -tangents[a]; break;
+                default: tangents[i] = local_derivative(i) * tangents[a]; break;
+            }
+        }
+        partial = tangents[root.index];
+        return values[root.index];
+    }
+
+    // Value of root and its gradient with respect to every variable: one
+    // forward loop, then one reverse loop accumulating adjoints
+    T value_and_gradient(node root, std::vector<T>& grad) {
+        check(root);
+        forward(root.index);
+        adjoints.assign(root.index + 1, T(0));
+        adjoints[root.index] = T(1);
+        for (index_type i = root.index + 1; i-- > 0;) {
+            const T w = adjoints[i];
+            const index_type a = lhs[i], b = rhs[i];
+            switch (ops[i]) {
+                case opcode::variable:
+                case opcode::constant: break;
+                case opcode::add: adjoints[a] += w; adjoints[b] += w; break;
+                case opcode::sub: adjoints[a] += w; adjoints[b] -= w; break;
+                case opcode::mul: adjoints[a] += w * values[b]; adjoints[b] += w * values[a]; break;
+                case opcode::div: {
+                    const T q = w / values[b];
+                    adjoints[a] += q;
+                    adjoints[b] -= q * values[i];
+                    break;
+                }
+                case opcode::neg: adjoints[a] -= w; break;
+                default: adjoints[a] += w * local_derivative(i); break;
+            }
+        }
+        grad.resize(inputs.size());
+        for (std::size_t k = 0; k < inputs.size(); ++k) {
+            grad[k] = inputs[k] <= root.index ? adjoints[inputs[k]] : T(0);
+        }
+        return values[root.index];
+    }
+
+    // Drops every node in O(1); the arrays keep their capacity
+    void release() {
+        ops.clear();
+        lhs.clear();
+        rhs.clear();
+        payload.clear();
+        inputs.clear();
+    }
+
+    void reserve(std::size_t nodes) {
+        ops.reserve(nodes);
+        lhs.reserve(nodes);
+        rhs.reserve(nodes);
+        payload.reserve(nodes);
+    }
+
+    private:
+    std::vector<opcode> ops;
+    std::vector<index_type> lhs, rhs;
+    std::vector<T> payload;           // constant value, variable value or exponent
+    std::vector<index_type> inputs;
+    std::vector<T> values, tangents, adjoints;   // per-pass scratch
+
+    node push(opcode op, index_type a, index_type b, T parameter) {
+        ops.push_back(op);
+        lhs.push_back(a);
+        rhs.push_back(b);
+        payload.push_back(parameter);
+        return node{this, static_cast<index_type>(ops.size() - 1)};
+    }
+
+    void check(node n) const {
+        if (n.pool != this || n.index >= ops.size()) {
+            throw std::invalid_argument("node does not belong to this expression pool");
+        }
+    }
+
+    void forward(index_type last) {
+        using std::sin; using std::cos; using std::tan; using std::exp;
+        using std::log; using std::sqrt; using std::tanh; using std::pow;
+        values.resize(last + 1);
+        for (index_type i = 0; i <= last; ++i) {
+            const index_type a = lhs[i], b = rhs[i];
+            T v;
+            switch (ops[i]) {
+                case opcode::variable:
+                case opcode::constant: v = payload[i]; break;
+                case opcode::add: v = values[a] + values[b]; break;
+                case opcode::sub: v = values[a] - values[b]; break;
+                case opcode::mul: v = values[a] * values[b]; break;
+                case opcode::div: v = values[a] / values[b]; break;
+                case opcode::neg: v = -values[a]; break;
+                case opcode::sin: v = sin(values[a]); break;
+                case opcode::cos: v = cos(values[a]); break;
+                case opcode::tan: v = tan(values[a]); break;
+                case opcode::exp: v = exp(values[a]); break;
+                case opcode::log: v = log(values[a]); break;
+                case opcode::sqrt: v = sqrt(values[a]); break;
+                case opcode::tanh: v = tanh(values[a]); break;
+                case opcode::pow_const: v = pow(values[a], payload[i]); break;
+                default: throw std::logic_error("unknown opcode");
+            }
+            values[i] = v;
+        }
+    }
+
+    // d node_i / d operand for the unary functions, from the forward values
+    T local_derivative(index_type i) const {
+        using std::sin; using std::cos; using std::pow;
+        const T x = values[lhs[i]], y = values[i];
+        switch (ops[i]) {
+            case opcode::sin: return cos(x);
+            case opcode::cos: return -sin(x);
+            case opcode::tan: return T(1) + y * y;
+            case opcode::exp: return y;
+            case opcode::log: return T(1) / x;
+            case opcode::sqrt: return T(1) / (T(2) * y);
+            case opcode::tanh: return T(1) - y * y;
+            case opcode::pow_const: return payload[i] * pow(x, payload[i] - T(1));
+            default: throw std::logic_error("not a unary function opcode");
+        }
+    }
+};
+
+// Graph building with ordinary operators
+
+template <typename T>
+pool_node<T> operator+(pool_node<T> a, pool_node<T> b) { return a.pool->binary(opcode::add, a, b); }
+template <typename T>
+pool_node<T> operator-(pool_node<T> a, pool_node<T> b) { return a.pool->binary(opcode::sub, a, b); }
+template <typename T>
+pool_node<T> operator*(pool_node<T> a, pool_node<T> b) { return a.pool->binary(opcode::mul, a, b); }
+template <typename T>
+pool_node<T> operator/(pool_node<T> a, pool_node<T> b) { return a.pool->binary(opcode::div, a, b); }
+template <typename T>
+pool_node<T> operator-(pool_node<T> a) { return a.pool->unary(opcode::neg, a); }
+
+template <typename T>
+pool_node<T> operator+(pool_node<T> a, std::type_identity_t<T> s) { return a + a.pool->constant(s); }
+template <typename T>
+pool_node<T> operator+(std::type_identity_t<T> s, pool_node<T> a) { return a.pool->constant(s) + a; }
+template <typename T>
+pool_node<T> operator-(pool_node<T> a, std::type_identity_t<T> s) { return a - a.pool->constant(s); }
+template <typename T>
+pool_node<T> operator-(std::type_identity_t<T> s, pool_node<T> a) { return a.pool->constant(s) - a; }
+template <typename T>
+pool_node<T> operator*(pool_node<T> a, std::type_identity_t<T> s) { return a * a.pool->constant(s); }
+template <typename T>
+pool_node<T> operator*(std::type_identity_t<T> s, pool_node<T> a) { return a.pool->constant(s) * a; }
+template <typename T>
+pool_node<T> operator/(pool_node<T> a, std::type_identity_t<T> s) { return a / a.pool->constant(s); }
+template <typename T>
+pool_node<T> operator/(std::type_identity_t<T> s, pool_node<T> a) { return a.pool->constant(s) / a; }
+
+template <typename T>
+pool_node<T> sin(pool_node<T> a) { return a.pool->unary(opcode::sin, a); }
+template <typename T>
+pool_node<T> cos(pool_node<T> a) { return a.pool->unary(opcode::cos, a); }
+template <typename T>
+pool_node<T> tan(pool_node<T> a) { return a.pool->unary(opcode::tan, a); }
+template <typename T>
+pool_node<T> exp(pool_node<T> a) { return a.pool->unary(opcode::exp, a); }
+template <typename T>
+pool_node<T> log(pool_node<T> a) { return a.pool->unary(opcode::log, a); }
+template <typename T>
+pool_node<T> sqrt(pool_node<T> a) { return a.pool->unary(opcode::sqrt, a); }
+template <typename T>
+pool_node<T> tanh(pool_node<T> a) { return a.pool->unary(opcode::tanh, a); }
+template <typename T>
+pool_node<T> pow(pool_node<T> a, std::type_identity_t<T> p) { return a.pool->unary(opcode::pow_const, a, p); }
+
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dual.h"
+#include "reverse_mode.h"
+
+// Second derivatives by forward-over-reverse differentiation.
+//
+// The objective is recorded on a tape whose values are dual numbers: the
+// value part carries x and the tangent lanes carry N directions v_k. One
+// backward sweep then yields the gradient in the value part of the
+// adjoints and the Hessian-vector products H v_k in their lanes, at a
+// small constant multiple of the cost of one gradient.
+//
+// Objectives are written once as generic callables,
+//
+//     auto f = [](const auto& x) { return x[0] * x[0] * x[1] + sin(x[1]); };
+//
+// and are called with std::vector<reverse_var<dual<T, N>>> for Hessian
+// products and std::vector<sparsity_tracer<T>> for pattern detection.
+//
+// Sparse Hessians: hessian_sparsity() traces which pairs of variables
+// interact nonlinearly, color_columns() groups structurally orthogonal
+// columns (no row has a nonzero in two columns of one color), and
+// sparse_hessian() gets every nonzero from one product with the sum of
+// the unit vectors of each color, so the cost follows the number of
+// colors rather than the number of variables.
+namespace autodiff {
+
+// Hessian-vector products H(x) v_k for up to N directions at once.
+// directions[k] has the size of x; returns one product per direction.
+template <int N, typename T, typename F>
+std::vector<std::vector<T>> hessian_vector_products(F&& f, const std::vector<T>& x,
+                                                    const std::vector<std::vector<T>>& directions,
+                                                    T* value = nullptr, std::vector<T>* gradient = nullptr)
+{
+    using lane_type = dual<T, N>;
+    const std::size_t n = x.size();
+    const int count = static_cast<int>(directions.size());
+    if (count > N) {
+        throw std::invalid_argument("more directions than dual lanes");
+    }
+
+    std::vector<lane_type> seeded(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        seeded[i].value = x[i];
+        for (int k = 0; k < count; ++k) {
+            if (directions[k].size() != n) {
+                throw std::invalid_argument("direction size does not match x");
+            }
+            seeded[i].tangent[k] = directions[k][i];
+        }
+    }
+
+    tape<lane_type> t;
+    const std::vector<reverse_var<lane_type>> vars = t.variables(seeded);
+    const reverse_var<lane_type> y = f(vars);
+    std::vector<lane_type> adjoints;
+    t.gradient(y, adjoints);
+
+    std::vector<std::vector<T>> products(count, std::vector<T>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int k = 0; k < count; ++k) products[k][i] = adjoints[i].tangent[k];
+    }
+    if (value) *value = y.value.value;
+    if (gradient) {
+        gradient->resize(n);
+        for (std::size_t i = 0; i < n; ++i) (*gradient)[i] = adjoints[i].value;
+    }
+    return products;
+}
+
+template <typename T, typename F>
+std::vector<T> hessian_vector_product(F&& f, const std::vector<T>& x, const std::vector<T>& v) {
+    return hessian_vector_products<1>(f, x, std::vector<std::vector<T>>{v})[0];
+}
+
+// Dense Hessian, N columns per backward sweep: ceil(n / N) sweeps
+template <int N, typename T, typename F>
+std::vector<std::vector<T>> hessian(F&& f, const std::vector<T>& x) {
+    const std::size_t n = x.size();
+    std::vector<std::vector<T>> h(n, std::vector<T>(n));
+    for (std::size_t first = 0; first < n; first += N) {
+        const std::size_t width = std::min<std::size_t>(N, n - first);
+        std::vector<std::vector<T>> directions(width, std::vector<T>(n, T(0)));
+        for (std::size_t k = 0; k < width; ++k) directions[k][first + k] = T(1);
+        const auto columns = hessian_vector_products<N>(f, x, directions);
+        for (std::size_t k = 0; k < width; ++k)
+            for (std::size_t i = 0; i < n; ++i) h[i][first + k] = columns[k][i];
+    }
+    return h;
+}
+
+// --- Sparsity ------------------------------------------------------------
+
+// Symmetric nonzero pattern: rows[i] lists, sorted, the j with H(i, j) != 0
+struct hessian_pattern {
+    int n = 0;
+    std::vector<std::vector<int>> rows;
+
+    explicit hessian_pattern(int n = 0) : n(n), rows(n) {}
+
+    std::size_t nonzeros() const {
+        std::size_t count = 0;
+        for (const auto& r : rows) count += r.size();
+        return count;
+    }
+
+    bool contains(int i, int j) const {
+        return std::binary_search(rows[i].begin(), rows[i].end(), j);
+    }
+};
+
+// Scalar that carries a value plus the set of variables it depends on,
+// and records every pair of variables that meets in a nonlinear operation
+// into a shared pattern. The result is conservative (a superset of the
+// true pattern) for the control flow taken at the traced point.
+template <typename T>
+struct sparsity_tracer {
+    T value{};
+    std::vector<int> deps;                 // sorted variable indices
+    hessian_pattern* pattern = nullptr;    // null for constants
+
+    sparsity_tracer() = default;
+    sparsity_tracer(T constant) : value(constant) {}
+};
+
+namespace detail {
+
+inline std::vector<int> merge_deps(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> out;
+    out.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out;
+}
+
+// H gets nonzeros at every (i, j) with i in a, j in b, and symmetrically
+inline void add_interactions(hessian_pattern* pattern, const std::vector<int>& a, const std::vector<int>& b) {
+    if (!pattern) return;
+    for (int i : a) {
+        std::vector<int>& row = pattern->rows[i];
+        std::vector<int> merged;
+        merged.reserve(row.size() + b.size());
+        std::set_union(row.begin(), row.end(), b.begin(), b.end(), std::back_inserter(merged));
+        row.swap(merged);
+    }
+    if (&a != &b) {
+        for (int j : b) {
+            std::vector<int>& row = pattern->rows[j];
+            std::vector<int> merged;
+            merged.reserve(row.size() + a.size());
+            std::set_union(row.begin(), row.end(), a.begin(), a.end(), std::back_inserter(merged));
+            row.swap(merged);
+        }
+    }
+}
+
+template <typename T>
+sparsity_tracer<T> traced(T value, std::vector<int> deps, hessian_pattern* pattern) {
+    sparsity_tracer<T> r(value);
+    r.deps = std::move(deps);
+    r.pattern = pattern;
+    return r;
+}
+
+// Linear in both operands: dependencies merge, no interactions
+template <typename T>
+sparsity_tracer<T> linear(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b, T value) {
+    return traced(value, merge_deps(a.deps, b.deps), a.pattern ? a.pattern : b.pattern);
+}
+
+// Nonlinear in the operand: all its variables interact with each other
+template <typename T>
+sparsity_tracer<T> nonlinear(const sparsity_tracer<T>& a, T value) {
+    add_interactions(a.pattern, a.deps, a.deps);
+    return traced(value, a.deps, a.pattern);
+}
+
+}
+
+template <typename T>
+sparsity_tracer<T> operator+(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) {
+    return detail::linear(a, b, a.value + b.value);
+}
+
+template <typename T>
+sparsity_tracer<T> operator-(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) {
+    return detail::linear(a, b, a.value - b.value);
+}
+
+template <typename T>
+sparsity_tracer<T> operator-(const sparsity_tracer<T>& a) {
+    return detail::traced(-a.value, a.deps, a.pattern);
+}
+
+template <typename T>
+sparsity_tracer<T> operator*(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) {
+    // d2(ab) = a d2b + b d2a + da db' + db da': only the cross terms are new
+    hessian_pattern* p = a.pattern ? a.pattern : b.pattern;
+    detail::add_interactions(p, a.deps, b.deps);
+    return detail::traced(a.value * b.value, detail::merge_deps(a.deps, b.deps), p);
+}
+
+template <typename T>
+sparsity_tracer<T> operator/(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) {
+    // a * (1 / b): 1 / b is nonlinear in b
+    hessian_pattern* p = a.pattern ? a.pattern : b.pattern;
+    detail::add_interactions(p, b.deps, b.deps);
+    detail::add_interactions(p, a.deps, b.deps);
+    return detail::traced(a.value / b.value, detail::merge_deps(a.deps, b.deps), p);
+}
+
+template <typename T>
+sparsity_tracer<T> operator+(const sparsity_tracer<T>& a, std::type_identity_t<T> s) { return detail::traced(a.value + s, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator+(std::type_identity_t<T> s, const sparsity_tracer<T>& a) { return detail::traced(s + a.value, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator-(const sparsity_tracer<T>& a, std::type_identity_t<T> s) { return detail::traced(a.value - s, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator-(std::type_identity_t<T> s, const sparsity_tracer<T>& a) { return detail::traced(s - a.value, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator*(const sparsity_tracer<T>& a, std::type_identity_t<T> s) { return detail::traced(a.value * s, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator*(std::type_identity_t<T> s, const sparsity_tracer<T>& a) { return detail::traced(s * a.value, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator/(const sparsity_tracer<T>& a, std::type_identity_t<T> s) { return detail::traced(a.value / s, a.deps, a.pattern); }
+template <typename T>
+sparsity_tracer<T> operator/(std::type_identity_t<T> s, const sparsity_tracer<T>& a) { return detail::nonlinear(a, s / a.value); }
+
+template <typename T>
+sparsity_tracer<T>& operator+=(sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a = a + b; }
+template <typename T>
+sparsity_tracer<T>& operator-=(sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a = a - b; }
+template <typename T>
+sparsity_tracer<T>& operator*=(sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a = a * b; }
+template <typename T>
+sparsity_tracer<T>& operator/=(sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a = a / b; }
+
+template <typename T>
+bool operator<(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a.value < b.value; }
+template <typename T>
+bool operator>(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a.value > b.value; }
+template <typename T>
+bool operator<=(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a.value <= b.value; }
+template <typename T>
+bool operator>=(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) { return a.value >= b.value; }
+
+#define AUTODIFF_TRACER_NONLINEAR(name)                                        \
+    template <typename T>                                                      \
+    sparsity_tracer<T> name(const sparsity_tracer<T>& a) {                     \
+        using std::name;                                                       \
+        return detail::nonlinear(a, name(a.value));                            \
+    }
+
+AUTODIFF_TRACER_NONLINEAR(sin)
+AUTODIFF_TRACER_NONLINEAR(cos)
+AUTODIFF_TRACER_NONLINEAR(tan)
+AUTODIFF_TRACER_NONLINEAR(asin)
+AUTODIFF_TRACER_NONLINEAR(acos)
+AUTODIFF_TRACER_NONLINEAR(atan)
+AUTODIFF_TRACER_NONLINEAR(sinh)
+AUTODIFF_TRACER_NONLINEAR(cosh)
+AUTODIFF_TRACER_NONLINEAR(tanh)
+AUTODIFF_TRACER_NONLINEAR(exp)
+AUTODIFF_TRACER_NONLINEAR(log)
+AUTODIFF_TRACER_NONLINEAR(sqrt)
+
+#undef AUTODIFF_TRACER_NONLINEAR
+
+// |a| is piecewise linear: no second derivative away from 0
+template <typename T>
+sparsity_tracer<T> abs(const sparsity_tracer<T>& a) {
+    return detail::traced(a.value < T(0) ? -a.value : a.value, a.deps, a.pattern);
+}
+
+template <typename T>
+sparsity_tracer<T> pow(const sparsity_tracer<T>& a, std::type_identity_t<T> p) {
+    using std::pow;
+    if (p == T(1)) return a;
+    if (p == T(0)) return sparsity_tracer<T>(T(1));
+    return detail::nonlinear(a, pow(a.value, p));
+}
+
+template <typename T>
+sparsity_tracer<T> pow(const sparsity_tracer<T>& a, const sparsity_tracer<T>& b) {
+    using std::pow;
+    sparsity_tracer<T> both = detail::linear(a, b, pow(a.value, b.value));
+    return detail::nonlinear(both, both.value);
+}
+
+template <typename T>
+sparsity_tracer<T> pow(std::type_identity_t<T> s, const sparsity_tracer<T>& b) {
+    using std::pow;
+    return detail::nonlinear(b, pow(s, b.value));
+}
+
+// Nonzero pattern of the Hessian of f at x, from one traced evaluation
+template <typename T, typename F>
+hessian_pattern hessian_sparsity(F&& f, const std::vector<T>& x) {
+    const int n = static_cast<int>(x.size());
+    hessian_pattern pattern(n);
+    std::vector<sparsity_tracer<T>> vars(n);
+    for (int i = 0; i < n; ++i) {
+        vars[i] = detail::traced(x[i], std::vector<int>{i}, &pattern);
+    }
+    f(vars);
+    return pattern;
+}
+
+// Greedy distance-2 coloring of the columns: two columns get different
+// colors when some row has a nonzero in both. Columns are visited in
+// decreasing order of degree (largest-first), which usually needs few
+// colors. Returns the color of each column; the count is max + 1.
+inline std::vector<int> color_columns(const hessian_pattern& pattern) {
+    const int n = pattern.n;
+    std::vector<int> order(n);
+    for (int j = 0; j < n; ++j) order[j] = j;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return pattern.rows[a].size() > pattern.rows[b].size();
+    });
+
+    std::vector<int> color(n, -1);
+    std::vector<int> forbidden(n, -1);   // forbidden[c] == j: color c taken for column j
+    for (int j : order) {
+        // Columns sharing a row with j: the pattern is symmetric, so the
+        // rows with a nonzero in column j are pattern.rows[j]
+        for (int i : pattern.rows[j]) {
+            for (int k : pattern.rows[i]) {
+                if (color[k] >= 0) forbidden[color[k]] = j;
+            }
+        }
+        int c = 0;
+        while (forbidden[c] == j) ++c;
+        color[j] = c;
+    }
+    return color;
+}
+
+// Hessian values on a known pattern: values[i][p] = H(i, pattern.rows[i][p])
+template <typename T>
+struct sparse_hessian_result {
+    hessian_pattern pattern;
+    std::vector<int> colors;
+    int num_colors = 0;
+    std::vector<std::vector<T>> values;
+
+    T operator()(int i, int j) const {
+        const auto& row = pattern.rows[i];
+        const auto it = std::lower_bound(row.begin(), row.end(), j);
+        return it != row.end() && *it == j ? values[i][it - row.begin()] : T(0);
+    }
+};
+
+// Hessian on a precomputed pattern and coloring: one Hessian-vector
+// product per color, N colors per backward sweep. Reuse pattern and
+// colors while the structure of f does not change.
+template <int N, typename T, typename F>
+sparse_hessian_result<T> sparse_hessian(F&& f, const std::vector<T>& x,
+                                        const hessian_pattern& pattern, const std::vector<int>& colors)
+{
+    const int n = static_cast<int>(x.size());
+    if (pattern.n != n || static_cast<int>(colors.size()) != n) {
+        throw std::invalid_argument("pattern and coloring do not match x");
+    }
+
+    sparse_hessian_result<T> result;
+    result.pattern = pattern;
+    result.colors = colors;
+    result.num_colors = n ? *std::max_element(colors.begin(), colors.end()) + 1 : 0;
+    result.values.resize(n);
+    for (int i = 0; i < n; ++i) result.values[i].assign(pattern.rows[i].size(), T(0));
+
+    for (int first = 0; first < result.num_colors; first += N) {
+        const int width = std::min(N, result.num_colors - first);
+        std::vector<std::vector<T>> seeds(width, std::vector<T>(n, T(0)));
+        for (int j = 0; j < n; ++j) {
+            if (colors[j] >= first && colors[j] < first + width) seeds[colors[j] - first][j] = T(1);
+        }
+        const auto compressed = hessian_vector_products<N>(f, x, seeds);
+
+        // Row i of H * seed_c is H(i, j) for the one column j of color c
+        // in row i's pattern
+        for (int i = 0; i < n; ++i) {
+            const auto& row = pattern.rows[i];
+            for (std::size_t p = 0; p < row.size(); ++p) {
+                const int c = colors[row[p]];
+                if (c >= first && c < first + width) result.values[i][p] = compressed[c - first][i];
+            }
+        }
+    }
+    return result;
+}
+
+// Detects the pattern at x, colors it and evaluates the Hessian
+template <int N, typename T, typename F>
+sparse_hessian_result<T> sparse_hessian(F&& f, const std::vector<T>& x) {
+    const hessian_pattern pattern = hessian_sparsity(f, x);
+    return sparse_hessian<N>(f, x, pattern, color_columns(pattern));
+}
+
+}
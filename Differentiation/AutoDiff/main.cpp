@@ -0,0 +1,282 @@
+#include "autodiff.h"
+#include "reverse_mode.h"
+#include "dual.h"
+#include "expression_pool.h"
+#include "hessian.h"
+#include "../../Optimization/Gradient-Based/Gradient descent/Generic/gradient_descent.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <cassert>
+#include <cmath>
+
+
+static bool close(double a, double b, double tol = 1e-12) {
+    return std::fabs(a - b) <= tol * (1.0 + std::fabs(b));
+}
+
+int main() {
+    // Test 1: Forward mode on an expression graph
+    std::cout << "Test 1: Forward mode expression graph\n";
+    {
+        variable<double> x(2.0), y(3.0);
+        multiply<double, expression<double>*, expression<double>*> xy(&x, &y);
+        plus<double, expression<double>*, expression<double>*> f(&xy, &x);   // x y + x
+        assert(close(f.evaluate_and_derive(&x).value, 8.0));
+        assert(close(f.evaluate_and_derive(&x).partial, 4.0));
+        assert(close(f.evaluate_and_derive(&y).partial, 2.0));
+    }
+    std::cout << "Forward mode passed\n\n";
+
+    // Test 2: Reverse mode gradient from one backward sweep
+    std::cout << "Test 2: Reverse mode gradient\n";
+    {
+        autodiff::tape<double> t;
+        auto x = t.variable(0.7), y = t.variable(-1.3), z = t.variable(2.1);
+        auto f = x * y * z + sin(x) * exp(y) - log(z) / x + pow(z, 3.0) + sqrt(x * x + y * y) + 2.0 / y;
+        std::vector<double> g = t.gradient(f);
+
+        const double xv = 0.7, yv = -1.3, zv = 2.1, r = std::sqrt(xv * xv + yv * yv);
+        assert(g.size() == 3);
+        assert(close(g[0], yv * zv + std::cos(xv) * std::exp(yv) + std::log(zv) / (xv * xv) + xv / r));
+        assert(close(g[1], xv * zv + std::sin(xv) * std::exp(yv) + yv / r - 2.0 / (yv * yv)));
+        assert(close(g[2], xv * yv - 1.0 / (zv * xv) + 3.0 * zv * zv));
+
+        // Constants mixed in do not take tape entries of their own and the
+        // gradient of a constant is zero
+        autodiff::reverse_var<double> c = 5.0;
+        std::vector<double> zero = t.gradient(c * 2.0);
+        assert(zero.size() == 3 && zero[0] == 0.0 && zero[1] == 0.0 && zero[2] == 0.0);
+    }
+    std::cout << "Reverse mode gradient passed\n\n";
+
+    // Test 3: Reverse mode matches forward mode on a wide function
+    std::cout << "Test 3: Reverse vs forward mode\n";
+    {
+        const int n = 50;
+        std::vector<double> x0(n);
+        for (int i = 0; i < n; ++i) x0[i] = 0.5 + 0.01 * i;
+
+        // f(x) = sum_i x_i x_{i+1}
+        auto f = [](const std::vector<autodiff::reverse_var<double>>& x) {
+            autodiff::reverse_var<double> sum = 0.0;
+            for (std::size_t i = 0; i + 1 < x.size(); ++i) sum += x[i] * x[i + 1];
+            return sum;
+        };
+        std::vector<double> grad;
+        autodiff::tape<double> t;
+        const double value = autodiff::value_and_gradient(f, x0, grad, t);
+        const std::size_t recorded = t.size();
+
+        double expected = 0.0;
+        for (int i = 0; i + 1 < n; ++i) expected += x0[i] * x0[i + 1];
+        assert(close(value, expected));
+        for (int i = 0; i < n; ++i) {
+            const double left = i > 0 ? x0[i - 1] : 0.0;
+            const double right = i + 1 < n ? x0[i + 1] : 0.0;
+            assert(close(grad[i], left + right));
+        }
+
+        // Re-recording reuses the tape
+        autodiff::value_and_gradient(f, x0, grad, t);
+        assert(t.size() == recorded);
+    }
+    std::cout << "Reverse vs forward mode passed\n\n";
+
+    // Test 4: Gradient descent on a reverse mode objective
+    std::cout << "Test 4: Gradient descent with reverse mode\n";
+    {
+        // (x - 1)^2 + 2 (y + 0.5)^2, minimum at (1, -0.5)
+        auto objective = [](const std::vector<autodiff::reverse_var<double>>& v) {
+            auto dx = v[0] - 1.0, dy = v[1] + 0.5;
+            return dx * dx + 2.0 * dy * dy;
+        };
+        std::vector<double> x = {3.0, 2.0};
+        gradient_descent(objective, x, 0.1, 500, 1e-14);
+        assert(std::fabs(x[0] - 1.0) < 1e-5);
+        assert(std::fabs(x[1] + 0.5) < 1e-5);
+    }
+    std::cout << "Gradient descent passed\n\n";
+
+    // Test 5: Multi-lane dual numbers
+    std::cout << "Test 5: Multi-lane dual numbers\n";
+    {
+        // A plain generic function, differentiated in both directions at once
+        auto f = [](auto x, auto y) { return x * sin(y) + exp(x / y) - pow(y, 2.0); };
+        autodiff::dual<double, 2> x(1.5, 0), y(0.8, 1);
+        auto r = f(x, y);
+        assert(close(r.value, 1.5 * std::sin(0.8) + std::exp(1.5 / 0.8) - 0.64));
+        assert(close(r.tangent[0], std::sin(0.8) + std::exp(1.5 / 0.8) / 0.8));
+        assert(close(r.tangent[1], 1.5 * std::cos(0.8) - std::exp(1.5 / 0.8) * 1.5 / 0.64 - 1.6));
+
+        // Jacobian of g(x) = (x0 x1 x2, sin(x0) + x3^2, log(x1) x4) in lane
+        // blocks of 4: two passes for 5 variables
+        auto g = [](const std::vector<autodiff::dual<double, 4>>& v) {
+            return std::vector<autodiff::dual<double, 4>>{
+                v[0] * v[1] * v[2], sin(v[0]) + v[3] * v[3], log(v[1]) * v[4]};
+        };
+        const std::vector<double> x0 = {0.3, 1.7, -2.0, 0.9, 4.0};
+        auto J = autodiff::jacobian<4>(g, x0);
+        assert(J.size() == 3 && J[0].size() == 5);
+        const double expected[3][5] = {
+            {1.7 * -2.0, 0.3 * -2.0, 0.3 * 1.7, 0.0, 0.0},
+            {std::cos(0.3), 0.0, 0.0, 1.8, 0.0},
+            {0.0, 4.0 / 1.7, 0.0, 0.0, std::log(1.7)}};
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 5; ++j)
+                assert(close(J[i][j], expected[i][j]));
+
+        // Gradient agrees with reverse mode
+        auto h = [](const auto& v) {
+            auto sum = v[0] * 0.0;
+            for (std::size_t i = 0; i + 1 < v.size(); ++i) sum += tanh(v[i]) * v[i + 1];
+            return sum;
+        };
+        std::vector<double> x1(11);
+        for (int i = 0; i < 11; ++i) x1[i] = 0.1 * i - 0.4;
+        std::vector<double> forward = autodiff::gradient<8>(h, x1), reverse;
+        autodiff::value_and_gradient(h, x1, reverse);
+        for (int i = 0; i < 11; ++i) assert(close(forward[i], reverse[i]));
+    }
+    std::cout << "Multi-lane dual numbers passed\n\n";
+
+    // Test 6: Flat expression pool
+    std::cout << "Test 6: Flat expression pool\n";
+    {
+        autodiff::expression_pool<double> pool;
+        auto x = pool.variable(0.7), y = pool.variable(-1.3), z = pool.variable(2.1);
+        auto f = x * y * z + sin(x) * exp(y) - log(z) / x + pow(z, 3.0) + sqrt(x * x + y * y) + 2.0 / y;
+
+        // Same function recorded on a tape as reference
+        autodiff::tape<double> t;
+        auto tx = t.variable(0.7), ty = t.variable(-1.3), tz = t.variable(2.1);
+        auto tf = tx * ty * tz + sin(tx) * exp(ty) - log(tz) / tx + pow(tz, 3.0) + sqrt(tx * tx + ty * ty) + 2.0 / ty;
+        std::vector<double> expected = t.gradient(tf);
+
+        std::vector<double> g;
+        assert(close(pool.value_and_gradient(f, g), tf.value));
+        assert(close(pool.evaluate(f), tf.value));
+        for (int k = 0; k < 3; ++k) assert(close(g[k], expected[k]));
+
+        double partial = 0.0;
+        pool.value_and_partial(f, y, partial);
+        assert(close(partial, expected[1]));
+
+        // New variable values reuse the graph
+        pool.set_variable(0, 1.1);
+        autodiff::tape<double> t2;
+        auto ux = t2.variable(1.1);
+        auto uf = ux * -1.3 * 2.1 + sin(ux) * std::exp(-1.3) - std::log(2.1) / ux + std::pow(2.1, 3.0)
+                + sqrt(ux * ux + 1.69) + 2.0 / -1.3;
+        pool.value_and_gradient(f, g);
+        assert(close(pool.evaluate(f), uf.value));
+        assert(close(g[0], t2.gradient(uf)[0]));
+
+        // Bulk release keeps the storage for the next graph
+        const std::size_t nodes = pool.size();
+        pool.release();
+        assert(pool.size() == 0 && pool.num_variables() == 0);
+        auto a = pool.variable(3.0);
+        auto q = a * a;
+        assert(close(pool.value_and_gradient(q, g), 9.0) && close(g[0], 6.0));
+        assert(pool.size() < nodes);
+    }
+    std::cout << "Flat expression pool passed\n\n";
+
+    // Test 7: Shared subexpressions are computed once per pass
+    std::cout << "Test 7: Common subexpression caching\n";
+    {
+        // f_0 = x, f_{k+1} = f_k * y + f_k: every level uses the previous one
+        // twice, so an uncached evaluation visits 2^depth paths
+        const int depth = 40;
+        variable<double> x(1.0), y(0.5);
+        std::vector<std::unique_ptr<expression<double>>> nodes;
+        expression<double>* f = &x;
+        for (int k = 0; k < depth; ++k) {
+            nodes.push_back(std::make_unique<multiply<double, expression<double>*, expression<double>*>>(f, &y));
+            expression<double>* scaled = nodes.back().get();
+            nodes.push_back(std::make_unique<plus<double, expression<double>*, expression<double>*>>(scaled, f));
+            f = nodes.back().get();
+        }
+
+        // f = x * 1.5^depth
+        const double scale = std::pow(1.5, depth);
+        value_and_partial<double> vx = f->evaluate_and_derive(&x);
+        assert(close(vx.value, scale) && close(vx.partial, scale));
+        assert(evaluation_pass::last_nodes_visited() == nodes.size() + 2);
+
+        // A second pass recomputes with the new variable value
+        x.value = 2.0;
+        value_and_partial<double> vy = f->evaluate_and_derive(&y);
+        assert(close(vy.value, 2.0 * scale));
+        assert(close(vy.partial, 2.0 * depth * std::pow(1.5, depth - 1)));
+        assert(evaluation_pass::last_nodes_visited() == nodes.size() + 2);
+    }
+    std::cout << "Common subexpression caching passed\n\n";
+
+    // Test 8: Hessians
+    std::cout << "Test 8: Hessians\n";
+    {
+        // Extended Rosenbrock: tridiagonal Hessian
+        auto rosenbrock = [](const auto& x) {
+            auto sum = x[0] * 0.0;
+            for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+                auto a = 1.0 - x[i];
+                auto b = x[i + 1] - x[i] * x[i];
+                sum += a * a + 100.0 * b * b;
+            }
+            return sum;
+        };
+        const int n = 12;
+        std::vector<double> x(n);
+        for (int i = 0; i < n; ++i) x[i] = 0.3 + 0.1 * std::sin(i);
+
+        // Analytic Hessian
+        std::vector<std::vector<double>> exact(n, std::vector<double>(n, 0.0));
+        for (int i = 0; i + 1 < n; ++i) {
+            exact[i][i] += 2.0 + 1200.0 * x[i] * x[i] - 400.0 * x[i + 1];
+            exact[i][i + 1] += -400.0 * x[i];
+            exact[i + 1][i] += -400.0 * x[i];
+            exact[i + 1][i + 1] += 200.0;
+        }
+
+        auto H = autodiff::hessian<4>(rosenbrock, x);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                assert(close(H[i][j], exact[i][j], 1e-10));
+
+        // Hessian-vector product with the gradient alongside
+        std::vector<double> v(n), grad;
+        for (int i = 0; i < n; ++i) v[i] = 1.0 / (1.0 + i);
+        double value = 0.0;
+        auto Hv = autodiff::hessian_vector_products<1>(rosenbrock, x, {v}, &value, &grad)[0];
+        std::vector<double> reverse;
+        autodiff::value_and_gradient(rosenbrock, x, reverse);
+        for (int i = 0; i < n; ++i) {
+            double expected = 0.0;
+            for (int j = 0; j < n; ++j) expected += exact[i][j] * v[j];
+            assert(close(Hv[i], expected, 1e-10));
+            assert(close(grad[i], reverse[i]));
+        }
+
+        // Sparsity: tridiagonal pattern, 3 colors whatever n is
+        autodiff::hessian_pattern pattern = autodiff::hessian_sparsity(rosenbrock, x);
+        assert(pattern.nonzeros() == static_cast<std::size_t>(3 * n - 2));
+        assert(pattern.contains(4, 5) && !pattern.contains(4, 6));
+        auto sparse = autodiff::sparse_hessian<2>(rosenbrock, x);
+        assert(sparse.num_colors == 3);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                assert(close(sparse(i, j), exact[i][j], 1e-10));
+
+        // Separable terms do not interact: x0 x1 + exp(x2) + x3 / x4
+        auto separable = [](const auto& x) { return x[0] * x[1] + exp(x[2]) + x[3] / x[4]; };
+        autodiff::hessian_pattern sp = autodiff::hessian_sparsity(separable, std::vector<double>{1, 2, 3, 4, 5});
+        assert(sp.contains(0, 1) && !sp.contains(0, 0) && sp.contains(2, 2));
+        assert(sp.contains(3, 4) && sp.contains(4, 4) && !sp.contains(3, 3) && !sp.contains(1, 2));
+    }
+    std::cout << "Hessians passed\n\n";
+
+    std::cout << "All tests passed successfully!\n";
+    return 0;
+}
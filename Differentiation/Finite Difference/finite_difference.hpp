@@ -1,9 +1,15 @@
 #pragma once
 #include <array>
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 constexpr std::size_t factorial(std::size_t n) {
     return (n <= 1) ? 1 : (n * factorial(n - 1));
@@ -12,60 +18,116 @@ constexpr std::size_t factorial(std::size_t n) {
 // Type-safe enum
 enum class Scheme { Forward, Backward, Centered };
 
-// Finite difference coefficients for Taylor series expansion
-// For simplicity, we hardcode some common stencils
+// Weights of the DerivOrder-th derivative at x0 from samples at the given
+// nodes (Fornberg, "Generation of finite difference formulas on
+// arbitrarily spaced grids", 1988). The nodes may be in any order and
+// spacing but must be distinct; at least DerivOrder + 1 are needed.
+//
+// Usable in constant expressions, where a repeated node is a compile error.
+template<std::size_t DerivOrder, typename T, std::size_t N>
+constexpr std::array<T, N> fornberg_weights(const std::array<T, N>& nodes, T x0 = T(0)) {
+    static_assert(N > DerivOrder, "fornberg_weights: need at least DerivOrder + 1 nodes");
+
+    // c[k][j]: weight of node j for the k-th derivative on the nodes seen so far
+    std::array<std::array<T, N>, DerivOrder + 1> c{};
+    c[0][0] = T(1);
+    T c1 = T(1);
+    T c4 = nodes[0] - x0;
+    for (std::size_t i = 1; i < N; ++i) {
+        const std::size_t mn = i < DerivOrder ? i : DerivOrder;
+        T c2 = T(1);
+        const T c5 = c4;
+        c4 = nodes[i] - x0;
+        for (std::size_t j = 0; j < i; ++j) {
+            const T c3 = nodes[i] - nodes[j];
+            if (c3 == T(0)) {
+                throw std::invalid_argument("fornberg_weights: nodes must be distinct");
+            }
+            c2 *= c3;
+            if (j == i - 1) {
+                for (std::size_t k = mn; k >= 1; --k) {
+                    c[k][i] = c1 * (static_cast<T>(k) * c[k - 1][i - 1] - c5 * c[k][i - 1]) / c2;
+                }
+                c[0][i] = -c1 * c5 * c[0][i - 1] / c2;
+            }
+            for (std::size_t k = mn; k >= 1; --k) {
+                c[k][j] = (c4 * c[k][j] - static_cast<T>(k) * c[k - 1][j]) / c3;
+            }
+            c[0][j] = c4 * c[0][j] / c3;
+        }
+        c1 = c2;
+    }
+    return c[DerivOrder];
+}
+
+// Uniform stencils in units of the step h. Accuracy is the reach of the
+// stencil: Forward samples x, x + h, ..., x + Accuracy h, Backward the
+// mirror image and Centered x - Accuracy h, ..., x + Accuracy h. The
+// coefficients are generated at compile time; combinations with too few
+// points for the derivative do not compile.
 template<Scheme scheme, std::size_t DerivOrder, std::size_t Accuracy>
-struct FDStencil;
-
-template<std::size_t DerivOrder, std::size_t Accuracy>
-struct FDStencil<Scheme::Forward, DerivOrder, Accuracy> {
-    static constexpr std::array<double, Accuracy + 1> coefficients = [] {
-        std::array<double, Accuracy + 1> coeffs{};
-        // Computing finite difference coefficients using forward difference table
-        // For first derivative, accuracy 1: [-1, 1]/h
-        // See: Fornberg algorithm for general case
-        if constexpr (DerivOrder == 1 && Accuracy == 1) {
-            coeffs[0] = -1.0;
-            coeffs[1] = 1.0;
-        } else if constexpr (DerivOrder == 1 && Accuracy == 2) {
-            coeffs[0] = -3.0 / 2;
-            coeffs[1] = 2.0;
-            coeffs[2] = -1.0 / 2;
+struct FDStencil {
+    static_assert(Accuracy >= 1, "FDStencil: Accuracy must be at least 1");
+
+    static constexpr std::size_t size = scheme == Scheme::Centered ? 2 * Accuracy + 1 : Accuracy + 1;
+    static_assert(size > DerivOrder, "FDStencil: too few points for this derivative order, raise Accuracy");
+
+    static constexpr std::array<double, size> offsets = [] {
+        std::array<double, size> nodes{};
+        for (std::size_t i = 0; i < size; ++i) {
+            if constexpr (scheme == Scheme::Forward) {
+                nodes[i] = static_cast<double>(i);
+            } else if constexpr (scheme == Scheme::Backward) {
+                nodes[i] = -static_cast<double>(i);
+            } else {
+                nodes[i] = static_cast<double>(i) - static_cast<double>(Accuracy);
+            }
         }
-        return coeffs;
+        return nodes;
     }();
-};
 
-template<std::size_t DerivOrder, std::size_t Accuracy>
-struct FDStencil<Scheme::Backward, DerivOrder, Accuracy> {
-    static constexpr std::array<double, Accuracy + 1> coefficients = [] {
-        std::array<double, Accuracy + 1> coeffs{};
-        if constexpr (DerivOrder == 1 && Accuracy == 1) {
-            coeffs[0] = 1.0;
-            coeffs[1] = -1.0;
-        } else if constexpr (DerivOrder == 1 && Accuracy == 2) {
-            coeffs[0] = 3.0 / 2;
-            coeffs[1] = -2.0;
-            coeffs[2] = 0.5;
+    // Centered weights are made exactly (anti)symmetric, c[i] = (-1)^D c[size-1-i],
+    // by averaging mirrored pairs; for odd derivatives the centre is exactly
+    // zero instead of rounding noise, so it is never evaluated
+    static constexpr std::array<double, size> coefficients = [] {
+        auto c = fornberg_weights<DerivOrder>(offsets);
+        if constexpr (scheme == Scheme::Centered) {
+            constexpr double sign = DerivOrder % 2 == 0 ? 1.0 : -1.0;
+            for (std::size_t i = 0; i < Accuracy; ++i) {
+                const std::size_t j = size - 1 - i;
+                const double left = 0.5 * (c[i] + sign * c[j]);
+                c[i] = left;
+                c[j] = sign * left;
+            }
+            if constexpr (DerivOrder % 2 == 1) c[Accuracy] = 0.0;
         }
-        return coeffs;
+        return c;
     }();
+
+    // Truncation error is O(h^order_of_accuracy); symmetric stencils gain
+    // one order when size - DerivOrder is odd
+    static constexpr std::size_t order_of_accuracy =
+        size - DerivOrder + (scheme == Scheme::Centered && (size - DerivOrder) % 2 == 1 ? 1 : 0);
 };
 
-template<std::size_t DerivOrder, std::size_t Accuracy>
-struct FDStencil<Scheme::Centered, DerivOrder, Accuracy> {
-    static constexpr std::array<double, Accuracy * 2 + 1> coefficients = [] {
-        std::array<double, Accuracy * 2 + 1> coeffs{};
-        if constexpr (DerivOrder == 1 && Accuracy == 1) {
-            coeffs[0] = -0.5;
-            coeffs[2] = 0.5;
-        } else if constexpr (DerivOrder == 2 && Accuracy == 1) {
-            coeffs[0] = 1.0;
-            coeffs[1] = -2.0;
-            coeffs[2] = 1.0;
+// Stencil on arbitrary offsets (in units of h, any spacing), e.g.
+//   NonUniformStencil<1, std::array{-1.0, 0.0, 0.5, 2.0}>
+template<std::size_t DerivOrder, auto Offsets>
+struct NonUniformStencil {
+    static constexpr std::size_t size = std::tuple_size_v<decltype(Offsets)>;
+    static_assert(size > DerivOrder, "NonUniformStencil: need at least DerivOrder + 1 offsets");
+
+    static constexpr auto offsets = Offsets;
+    static constexpr auto coefficients = fornberg_weights<DerivOrder>(Offsets);
+
+    template<typename Func, typename T>
+    static T differentiate(Func f, T x, T h) {
+        T result = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            result += static_cast<T>(coefficients[i]) * f(x + static_cast<T>(offsets[i]) * h);
         }
-        return coeffs;
-    }();
+        return result / std::pow(h, DerivOrder);
+    }
 };
 
 // Core differentiation class
@@ -77,31 +139,98 @@ template<
 >
 class FiniteDifference {
 public:
-    static constexpr std::size_t stencil_size = 
-        scheme == Scheme::Centered ? (2 * Accuracy + 1) : (Accuracy + 1);
+    using Stencil = FDStencil<scheme, DerivOrder, Accuracy>;
+    static constexpr std::size_t stencil_size = Stencil::size;
 
     template<typename Func>
     static T differentiate(Func f, T x, T h) {
         static_assert(std::is_invocable_r_v<T, Func, T>, "Function must be callable with T -> T");
-        const auto& coeffs = FDStencil<scheme, DerivOrder, Accuracy>::coefficients;
         T result = 0;
         for (std::size_t i = 0; i < stencil_size; ++i) {
-            T xi = x + offset(i, h);
-            result += coeffs[i] * f(xi);
+            if (Stencil::coefficients[i] == 0.0) continue;   // e.g. the center of odd derivatives
+            T xi = x + static_cast<T>(Stencil::offsets[i]) * h;
+            result += static_cast<T>(Stencil::coefficients[i]) * f(xi);
         }
         return result / std::pow(h, DerivOrder);
     }
+};
 
-private:
-    static constexpr T offset(std::size_t i, T h) {
-        if constexpr (scheme == Scheme::Forward) {
-            return i * h;
-        } else if constexpr (scheme == Scheme::Backward) {
-            return -static_cast<T>(i) * h;
-        } else if constexpr (scheme == Scheme::Centered) {
-            return (static_cast<T>(i) - static_cast<T>(Accuracy)) * h;
-        }
-        return 0;
-    }
+
+template<typename T>
+struct AdaptiveDerivative {
+    T value;
+    T error;                    // estimated absolute error of value
+    std::size_t evaluations;    // calls to f
 };
 
+// Derivative with an automatically chosen step (Ridders' method).
+//
+// The centered stencil is evaluated at h, h / shrink, h / shrink^2, ...
+// and each new estimate is Richardson-extrapolated against all the
+// previous ones, so every function value keeps contributing to the
+// tableau. f(x), which even derivatives need at every step, is computed
+// once. Stops when the error estimate reaches tolerance, when it starts
+// to grow (cancellation has taken over) or before the next step would
+// exceed max_evaluations; the best estimate seen is returned.
+template<std::size_t DerivOrder = 1, std::size_t Accuracy = 1, typename T, typename Func>
+AdaptiveDerivative<T> adaptive_derivative(Func f, T x, T h, std::size_t max_evaluations = 40,
+                                          T tolerance = T(0), T shrink = T(1.4)) {
+    static_assert(std::is_invocable_r_v<T, Func, T>, "Function must be callable with T -> T");
+    using Stencil = FDStencil<Scheme::Centered, DerivOrder, Accuracy>;
+    constexpr std::size_t center = Accuracy;
+    constexpr bool needs_center = Stencil::coefficients[center] != 0.0;
+    constexpr std::size_t per_step = Stencil::size - 1;
+
+    if (!(h > T(0)) || !(shrink > T(1))) {
+        throw std::invalid_argument("adaptive_derivative: need h > 0 and shrink > 1");
+    }
+    if (max_evaluations < per_step + (needs_center ? 1 : 0)) {
+        throw std::invalid_argument("adaptive_derivative: max_evaluations is below one stencil");
+    }
+
+    AdaptiveDerivative<T> best{T(0), std::numeric_limits<T>::infinity(), 0};
+    T f0 = T(0);
+    if constexpr (needs_center) {
+        f0 = f(x);
+        best.evaluations = 1;
+    }
+
+    auto estimate = [&](T step) {
+        T sum = static_cast<T>(Stencil::coefficients[center]) * f0;
+        for (std::size_t i = 0; i < Stencil::size; ++i) {
+            if (i == center) continue;
+            sum += static_cast<T>(Stencil::coefficients[i]) * f(x + static_cast<T>(Stencil::offsets[i]) * step);
+        }
+        best.evaluations += per_step;
+        T scale = T(1);
+        for (std::size_t k = 0; k < DerivOrder; ++k) scale /= step;
+        return sum * scale;
+    };
+
+    // The error expands in h^p, h^(p + 2), ... for symmetric stencils
+    constexpr std::size_t p = Stencil::order_of_accuracy;
+    std::vector<T> previous, row;
+    T step = h;
+    while (best.evaluations + per_step <= max_evaluations) {
+        row.assign(1, estimate(step));
+        T factor = std::pow(shrink, static_cast<T>(p));
+        for (std::size_t j = 1; j <= previous.size(); ++j) {
+            row.push_back((factor * row[j - 1] - previous[j - 1]) / (factor - T(1)));
+            factor *= shrink * shrink;
+            const T error = std::max(std::abs(row[j] - row[j - 1]), std::abs(row[j] - previous[j - 1]));
+            if (error <= best.error) {
+                best.value = row[j];
+                best.error = error;
+            }
+        }
+        if (previous.empty()) {
+            best.value = row[0];
+        } else if (std::abs(row.back() - previous.back()) >= T(2) * best.error) {
+            break;   // higher order no longer helps
+        }
+        if (best.error <= tolerance) break;
+        previous.swap(row);
+        step /= shrink;
+    }
+    return best;
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "finite_difference.hpp"
+
+// Finite differences of sampled data: 1-D arrays, and 2-D / 3-D grids
+// along any axis, with the FDStencil coefficients.
+//
+// Interior points use the centered stencil of reach Accuracy. The first
+// and last Accuracy points use one-sided stencils with the same number
+// of points, shifted to stay inside the data, so every output has a
+// truncation error of at least O(h^(2 Accuracy + 1 - DerivOrder)).
+//
+// Grids are row-major with the last axis contiguous. Along the last axis
+// each row is a 1-D problem vectorized over the row. Along any other axis
+// the stencil combines whole rows of the next axes, so the inner loop is
+// again unit-stride; those rows are processed in tiles of grid_tile
+// elements so that the 2 Accuracy + 1 input rows of a tile stay in cache.
+// With OpenMP the rows / tiles are shared out between threads.
+template<std::size_t DerivOrder, std::size_t Accuracy, typename T = double>
+class GridDifference {
+public:
+    using Stencil = FDStencil<Scheme::Centered, DerivOrder, Accuracy>;
+    static constexpr std::size_t stencil_size = Stencil::size;
+
+    // Elements per tile across the inner axes
+    static constexpr std::size_t grid_tile = 512;
+    // Smallest number of output points for which OpenMP splits the work
+    static constexpr std::size_t parallel_threshold = 1 << 15;
+
+    // left_boundary[i]: stencil for the point i steps from the left edge
+    // (i < Accuracy), sampling points 0 .. stencil_size - 1
+    static constexpr auto left_boundary = [] {
+        std::array<std::array<double, stencil_size>, Accuracy> weights{};
+        for (std::size_t i = 0; i < Accuracy; ++i) {
+            std::array<double, stencil_size> nodes{};
+            for (std::size_t j = 0; j < stencil_size; ++j) {
+                nodes[j] = static_cast<double>(j) - static_cast<double>(i);
+            }
+            weights[i] = fornberg_weights<DerivOrder>(nodes);
+        }
+        return weights;
+    }();
+
+    // right_boundary[i]: point i steps from the right edge, sampling the
+    // last stencil_size points in increasing order
+    static constexpr auto right_boundary = [] {
+        std::array<std::array<double, stencil_size>, Accuracy> weights{};
+        for (std::size_t i = 0; i < Accuracy; ++i) {
+            std::array<double, stencil_size> nodes{};
+            for (std::size_t j = 0; j < stencil_size; ++j) {
+                nodes[j] = static_cast<double>(j) - static_cast<double>(stencil_size - 1 - i);
+            }
+            weights[i] = fornberg_weights<DerivOrder>(nodes);
+        }
+        return weights;
+    }();
+
+    // out[i] = d^DerivOrder y / dx^DerivOrder at x_i, where y[i] = f(x_0 + i h)
+    static void apply(const T* y, std::size_t n, T h, T* out) {
+        check_extent(n);
+        apply_row(y, n, inverse_step(h), out);
+    }
+
+    static std::vector<T> apply(const std::vector<T>& y, T h) {
+        std::vector<T> out(y.size());
+        apply(y.data(), y.size(), h, out.data());
+        return out;
+    }
+
+    // Derivative along axis of a row-major grid with the given extents
+    // (e.g. {nz, ny, nx}). out has the shape of data and must not alias it.
+    template<std::size_t Dim>
+    static void apply(const T* data, const std::array<std::size_t, Dim>& extents, std::size_t axis, T h,
+                      T* out) {
+        static_assert(Dim >= 1, "GridDifference: grid needs at least one axis");
+        if (axis >= Dim) {
+            throw std::invalid_argument("GridDifference: axis out of range");
+        }
+        check_extent(extents[axis]);
+
+        std::size_t outer = 1, inner = 1;
+        for (std::size_t d = 0; d < axis; ++d) outer *= extents[d];
+        for (std::size_t d = axis + 1; d < Dim; ++d) inner *= extents[d];
+        const std::size_t n = extents[axis];
+        const T scale = inverse_step(h);
+#if defined(_OPENMP)
+        const long long total = static_cast<long long>(outer * n * inner);
+#endif
+
+        if (inner == 1) {
+#if defined(_OPENMP)
+            #pragma omp parallel for schedule(static) if (total >= static_cast<long long>(parallel_threshold))
+#endif
+            for (long long o = 0; o < static_cast<long long>(outer); ++o) {
+                apply_row(data + o * n, n, scale, out + o * n);
+            }
+            return;
+        }
+
+        // One task is a slab: one outer index and one tile of the inner axes
+        const std::size_t tiles = (inner + grid_tile - 1) / grid_tile;
+#if defined(_OPENMP)
+        #pragma omp parallel for schedule(static) if (total >= static_cast<long long>(parallel_threshold))
+#endif
+        for (long long task = 0; task < static_cast<long long>(outer * tiles); ++task) {
+            const std::size_t o = static_cast<std::size_t>(task) / tiles;
+            const std::size_t j0 = static_cast<std::size_t>(task) % tiles * grid_tile;
+            const std::size_t j1 = std::min(j0 + grid_tile, inner);
+            apply_strided(data + o * n * inner, n, inner, j0, j1, scale, out + o * n * inner);
+        }
+    }
+
+private:
+    static void check_extent(std::size_t n) {
+        if (n < stencil_size) {
+            throw std::invalid_argument("GridDifference: need at least 2 * Accuracy + 1 points along the axis");
+        }
+    }
+
+    static T inverse_step(T h) {
+        T scale = T(1);
+        for (std::size_t k = 0; k < DerivOrder; ++k) scale /= h;
+        return scale;
+    }
+
+    template<std::size_t N>
+    static T dot(const std::array<double, N>& c, const T* y, std::size_t stride) {
+        T sum = 0;
+        for (std::size_t k = 0; k < N; ++k) sum += static_cast<T>(c[k]) * y[k * stride];
+        return sum;
+    }
+
+    // Contiguous row of n samples
+    static void apply_row(const T* y, std::size_t n, T scale, T* out) {
+        constexpr auto& c = Stencil::coefficients;
+        for (std::size_t i = 0; i < Accuracy; ++i) {
+            out[i] = scale * dot(left_boundary[i], y, 1);
+            out[n - 1 - i] = scale * dot(right_boundary[i], y + n - stencil_size, 1);
+        }
+        // Fixed-length inner sum, so the loop over i vectorizes
+        for (std::size_t i = Accuracy; i < n - Accuracy; ++i) {
+            T sum = 0;
+            for (std::size_t k = 0; k < stencil_size; ++k) {
+                sum += static_cast<T>(c[k]) * y[i - Accuracy + k];
+            }
+            out[i] = scale * sum;
+        }
+    }
+
+    // n rows of length inner; updates columns [j0, j1) of every row
+    static void apply_strided(const T* y, std::size_t n, std::size_t inner, std::size_t j0, std::size_t j1,
+                              T scale, T* out) {
+        constexpr auto& c = Stencil::coefficients;
+        auto combine = [&](const std::array<double, stencil_size>& w, const T* rows, T* dst) {
+            for (std::size_t j = j0; j < j1; ++j) {
+                T sum = 0;
+                for (std::size_t k = 0; k < stencil_size; ++k) {
+                    sum += static_cast<T>(w[k]) * rows[k * inner + j];
+                }
+                dst[j] = scale * sum;
+            }
+        };
+        for (std::size_t i = 0; i < Accuracy; ++i) {
+            combine(left_boundary[i], y, out + i * inner);
+            combine(right_boundary[i], y + (n - stencil_size) * inner, out + (n - 1 - i) * inner);
+        }
+        for (std::size_t i = Accuracy; i < n - Accuracy; ++i) {
+            combine(c, y + (i - Accuracy) * inner, out + i * inner);
+        }
+    }
+};
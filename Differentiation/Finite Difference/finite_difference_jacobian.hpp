@@ -0,0 +1,236 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Jacobians and gradients of black-box functions by differences.
+//
+// The functions take const std::vector<S>& and return std::vector<S>
+// (Jacobians) or S (gradients). For JacobianMethod::ComplexStep S must be
+// a template parameter, e.g. a generic lambda, since the function is
+// called with std::complex<T>: f(x + i h e_j) = f(x) + i h J e_j + O(h^2)
+// gives the column from the imaginary part with no subtraction, so h can
+// be tiny and the result is accurate to rounding. The function must be
+// real-analytic (no abs, comparisons on the value, etc.).
+//
+// Columns are independent, so with OpenMP they are evaluated in parallel;
+// f must then be safe to call from several threads.
+//
+// Column compression: columns that share no nonzero row can be perturbed
+// together, so a Jacobian whose sparsity pattern needs c colors costs c
+// (forward, complex step) or 2c (centered) evaluations instead of n or 2n.
+enum class JacobianMethod { Forward, Centered, ComplexStep };
+
+// Nonzero columns of each row of an m x n Jacobian
+struct JacobianPattern {
+    std::size_t rows = 0, cols = 0;
+    std::vector<std::vector<std::size_t>> nonzeros;
+};
+
+// Greedy coloring of the columns, largest columns first: columns of one
+// color never share a row. Returns the color of each column.
+inline std::vector<std::size_t> color_jacobian_columns(const JacobianPattern& pattern) {
+    std::vector<std::vector<std::size_t>> column_rows(pattern.cols);
+    for (std::size_t i = 0; i < pattern.nonzeros.size(); ++i) {
+        for (std::size_t j : pattern.nonzeros[i]) {
+            if (j >= pattern.cols) throw std::invalid_argument("color_jacobian_columns: column out of range");
+            column_rows[j].push_back(i);
+        }
+    }
+    std::vector<std::size_t> order(pattern.cols);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return column_rows[a].size() > column_rows[b].size();
+    });
+
+    constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> colors(pattern.cols, none);
+    std::vector<std::size_t> used_by(pattern.cols, none);   // color -> last column that excluded it
+    for (std::size_t j : order) {
+        for (std::size_t i : column_rows[j]) {
+            for (std::size_t k : pattern.nonzeros[i]) {
+                if (colors[k] != none) used_by[colors[k]] = j;
+            }
+        }
+        std::size_t c = 0;
+        while (used_by[c] == j) ++c;
+        colors[j] = c;
+    }
+    return colors;
+}
+
+namespace fd_detail {
+
+template<typename T>
+T default_step(JacobianMethod method, T x) {
+    const T eps = std::numeric_limits<T>::epsilon();
+    const T scale = std::max(T(1), std::abs(x));
+    switch (method) {
+        case JacobianMethod::Forward: return std::sqrt(eps) * scale;
+        case JacobianMethod::Centered: return std::cbrt(eps) * scale;
+        case JacobianMethod::ComplexStep: return T(1e-20) * scale;
+    }
+    return T(0);
+}
+
+// Makes x + h - x == h exactly, removing the rounding of the step
+template<typename T>
+T representable(T x, T h) {
+    volatile T shifted = x + h;
+    return shifted - x;
+}
+
+// Smallest evaluations * size for which the columns are split across threads
+constexpr long long jacobian_parallel_threshold = 1 << 12;
+
+}
+
+// Row-major m x n Jacobian of f: R^n -> R^m, jac[i * n + j] = df_i/dx_j,
+// perturbing the columns of each color together. colors may be empty (one
+// color per column, the dense Jacobian); entries outside pattern are zero
+// when colors comes from color_jacobian_columns(pattern).
+template<typename T = double, typename F>
+std::vector<T> fd_jacobian(F&& f, const std::vector<T>& x, const std::vector<std::size_t>& colors,
+                           JacobianMethod method = JacobianMethod::Centered,
+                           const JacobianPattern* pattern = nullptr) {
+    const std::size_t n = x.size();
+    if (!colors.empty() && colors.size() != n) {
+        throw std::invalid_argument("fd_jacobian: need one color per variable");
+    }
+
+    // The complex path is only instantiated for functions that accept it
+    constexpr bool complex_callable = std::is_invocable_v<F&, const std::vector<std::complex<T>>&>;
+    if (method == JacobianMethod::ComplexStep && !complex_callable) {
+        throw std::invalid_argument("fd_jacobian: the complex step needs f to accept std::complex values");
+    }
+
+    std::vector<T> f0;
+    if constexpr (complex_callable) {
+        if (method == JacobianMethod::ComplexStep) {
+            const std::vector<std::complex<T>> xc(x.begin(), x.end());
+            const auto fc = f(xc);
+            f0.resize(fc.size());
+            for (std::size_t i = 0; i < fc.size(); ++i) f0[i] = fc[i].real();
+        }
+    }
+    if (method != JacobianMethod::ComplexStep) {
+        f0 = f(x);
+    }
+    const std::size_t m = f0.size();
+
+    // Columns of each color
+    std::size_t num_colors = n;
+    std::vector<std::vector<std::size_t>> groups;
+    if (colors.empty()) {
+        groups.resize(n);
+        for (std::size_t j = 0; j < n; ++j) groups[j] = {j};
+    } else {
+        num_colors = *std::max_element(colors.begin(), colors.end()) + 1;
+        groups.resize(num_colors);
+        for (std::size_t j = 0; j < n; ++j) groups[colors[j]].push_back(j);
+    }
+
+    // Rows of each column: a compressed evaluation mixes the columns of a
+    // color, which the pattern separates again
+    std::vector<std::vector<std::size_t>> column_rows;
+    if (pattern && !colors.empty()) {
+        column_rows.resize(n);
+        for (std::size_t i = 0; i < pattern->nonzeros.size(); ++i) {
+            for (std::size_t j : pattern->nonzeros[i]) column_rows[j].push_back(i);
+        }
+    } else if (num_colors != n) {
+        throw std::invalid_argument("fd_jacobian: compressed columns need the sparsity pattern");
+    }
+
+    std::vector<T> jac(m * n, T(0));
+    auto scatter = [&](std::size_t j, const std::vector<T>& column) {
+        if (column_rows.empty()) {
+            for (std::size_t i = 0; i < m; ++i) jac[i * n + j] = column[i];
+        } else {
+            for (std::size_t i : column_rows[j]) jac[i * n + j] = column[i];
+        }
+    };
+
+#if defined(_OPENMP)
+    const std::size_t per_color = method == JacobianMethod::Centered ? 2 : 1;
+    const long long work = static_cast<long long>(per_color * num_colors * (m + n));
+    #pragma omp parallel for schedule(dynamic) if (work >= fd_detail::jacobian_parallel_threshold)
+#endif
+    for (long long c = 0; c < static_cast<long long>(num_colors); ++c) {
+        const auto& group = groups[static_cast<std::size_t>(c)];
+        if (group.empty()) continue;
+
+        if constexpr (complex_callable) {
+            if (method == JacobianMethod::ComplexStep) {
+                std::vector<std::complex<T>> xc(x.begin(), x.end());
+                std::vector<T> steps(group.size());
+                for (std::size_t g = 0; g < group.size(); ++g) {
+                    steps[g] = fd_detail::default_step(method, x[group[g]]);
+                    xc[group[g]] += std::complex<T>(T(0), steps[g]);
+                }
+                const auto fc = f(xc);
+                for (std::size_t g = 0; g < group.size(); ++g) {
+                    std::vector<T> column(m);
+                    for (std::size_t i = 0; i < m; ++i) column[i] = fc[i].imag() / steps[g];
+                    scatter(group[g], column);
+                }
+                continue;
+            }
+        }
+
+        std::vector<T> xp = x, xm = x, steps(group.size());
+        for (std::size_t g = 0; g < group.size(); ++g) {
+            const std::size_t j = group[g];
+            steps[g] = fd_detail::representable(x[j], fd_detail::default_step(method, x[j]));
+            xp[j] += steps[g];
+            xm[j] -= steps[g];
+        }
+        const std::vector<T> fp = f(xp);
+        const std::vector<T> fm = method == JacobianMethod::Centered ? f(xm) : f0;
+        const T width = method == JacobianMethod::Centered ? T(2) : T(1);
+        for (std::size_t g = 0; g < group.size(); ++g) {
+            std::vector<T> column(m);
+            for (std::size_t i = 0; i < m; ++i) column[i] = (fp[i] - fm[i]) / (width * steps[g]);
+            scatter(group[g], column);
+        }
+    }
+    return jac;
+}
+
+// Dense Jacobian, one column per evaluation (two for Centered)
+template<typename T = double, typename F>
+std::vector<T> fd_jacobian(F&& f, const std::vector<T>& x, JacobianMethod method = JacobianMethod::Centered) {
+    return fd_jacobian<T>(f, x, std::vector<std::size_t>{}, method);
+}
+
+// Jacobian with the given sparsity pattern, compressed by column coloring
+template<typename T = double, typename F>
+std::vector<T> fd_jacobian(F&& f, const std::vector<T>& x, const JacobianPattern& pattern,
+                           JacobianMethod method = JacobianMethod::Centered) {
+    return fd_jacobian<T>(f, x, color_jacobian_columns(pattern), method, &pattern);
+}
+
+// Gradient of a scalar function f: R^n -> R
+template<typename T = double, typename F>
+std::vector<T> fd_gradient(F&& f, const std::vector<T>& x, JacobianMethod method = JacobianMethod::Centered) {
+    // The declared return type keeps the lambda SFINAE-friendly, so the
+    // complex_callable test in fd_jacobian sees whether f takes complex
+    // vectors instead of failing inside the body
+    auto as_vector = [&](const auto& v) -> std::vector<std::decay_t<decltype(f(v))>> {
+        return {f(v)};
+    };
+    return fd_jacobian<T>(as_vector, x, std::vector<std::size_t>{}, method);
+}
+
+// f'(x) of a scalar function by the complex step; f must accept std::complex<T>
+template<typename T = double, typename F>
+T complex_step_derivative(F&& f, T x) {
+    const T h = fd_detail::default_step(JacobianMethod::ComplexStep, x);
+    return f(std::complex<T>(x, h)).imag() / h;
+}
@@ -1,6 +1,31 @@
 #include <iostream>
+#include <cassert>
 #include <cmath>
+#include <vector>
 #include "finite_difference.hpp"
+#include "finite_difference_grid.hpp"
+#include "finite_difference_jacobian.hpp"
+
+// The hard-coded stencils this header used to carry, now generated
+static_assert(FDStencil<Scheme::Forward, 1, 1>::coefficients == std::array{-1.0, 1.0});
+static_assert(FDStencil<Scheme::Forward, 1, 2>::coefficients == std::array{-1.5, 2.0, -0.5});
+static_assert(FDStencil<Scheme::Backward, 1, 2>::coefficients == std::array{1.5, -2.0, 0.5});
+static_assert(FDStencil<Scheme::Centered, 1, 1>::coefficients == std::array{-0.5, 0.0, 0.5});
+static_assert(FDStencil<Scheme::Centered, 2, 1>::coefficients == std::array{1.0, -2.0, 1.0});
+// Odd derivatives: the centre weight is exactly zero at any accuracy
+static_assert(FDStencil<Scheme::Centered, 1, 3>::coefficients[3] == 0.0);
+static_assert(FDStencil<Scheme::Centered, 1, 4>::coefficients[4] == 0.0);
+static_assert(FDStencil<Scheme::Centered, 3, 4>::coefficients[4] == 0.0);
+static_assert(FDStencil<Scheme::Centered, 3, 4>::coefficients[1] == -FDStencil<Scheme::Centered, 3, 4>::coefficients[7]);
+static_assert(FDStencil<Scheme::Centered, 2, 1>::order_of_accuracy == 2);
+static_assert(FDStencil<Scheme::Centered, 4, 2>::order_of_accuracy == 2);
+static_assert(FDStencil<Scheme::Forward, 2, 3>::order_of_accuracy == 2);
+
+constexpr bool near(double a, double b) { return (a > b ? a - b : b - a) < 1e-12; }
+
+// Five-point fourth derivative: 1, -4, 6, -4, 1
+constexpr auto fourth = FDStencil<Scheme::Centered, 4, 2>::coefficients;
+static_assert(near(fourth[0], 1) && near(fourth[1], -4) && near(fourth[2], 6) && near(fourth[3], -4) && near(fourth[4], 1));
 
 int main() {
     auto f = [](double x) { return std::sin(x); };
@@ -12,4 +37,126 @@ int main() {
 
     std::cout << "Approximate f'(x): " << derivative << "\n";
     std::cout << "Exact      f'(x): " << std::cos(x) << "\n";
+    assert(std::fabs(derivative - std::cos(x)) < 1e-6);
+
+    // Higher accuracy and higher derivatives
+    double d1 = FiniteDifference<Scheme::Centered, 1, 3>::differentiate(f, x, 1e-2);
+    assert(std::fabs(d1 - std::cos(x)) < 1e-11);
+    double d3 = FiniteDifference<Scheme::Forward, 3, 6>::differentiate(f, x, 1e-2);
+    assert(std::fabs(d3 + std::cos(x)) < 1e-6);
+    double d2 = FiniteDifference<Scheme::Backward, 2, 4>::differentiate(f, x, 1e-2);
+    assert(std::fabs(d2 + std::sin(x)) < 1e-6);
+
+    // Non-uniform offsets: exact for polynomials up to degree size - 1
+    using Skewed = NonUniformStencil<1, std::array{-1.0, 0.0, 0.5, 2.0}>;
+    auto cubic = [](double t) { return t * t * t - 2 * t; };
+    double skewed = Skewed::differentiate(cubic, 1.5, 0.1);
+    std::cout << "Non-uniform f'(1.5): " << skewed << "\n";
+    assert(std::fabs(skewed - (3 * 1.5 * 1.5 - 2)) < 1e-10);
+
+    // The same weights at run time
+    auto weights = fornberg_weights<2>(std::array{0.0, 0.3, 1.0});
+    assert(std::fabs(weights[0] * 0.0 + weights[1] * 0.09 + weights[2] * 1.0 - 2.0) < 1e-12);
+
+    // Sampled data, boundaries included: second derivative of sin on [0, 2]
+    const std::size_t n = 201;
+    const double step = 2.0 / (n - 1);
+    std::vector<double> samples(n);
+    for (std::size_t i = 0; i < n; ++i) samples[i] = std::sin(i * step);
+    auto curvature = GridDifference<2, 2>::apply(samples, step);
+    for (std::size_t i = 0; i < n; ++i) assert(std::fabs(curvature[i] + samples[i]) < 1e-5);
+
+    // 3-D grid u = sin(x) cos(2 y) exp(z / 2), extents {nz, ny, nx}
+    const std::array<std::size_t, 3> extents{17, 23, 600};
+    const double g = 0.01;
+    std::vector<double> u(extents[0] * extents[1] * extents[2]), du(u.size());
+    auto at = [&](std::size_t k, std::size_t j, std::size_t i) { return (k * extents[1] + j) * extents[2] + i; };
+    for (std::size_t k = 0; k < extents[0]; ++k)
+        for (std::size_t j = 0; j < extents[1]; ++j)
+            for (std::size_t i = 0; i < extents[2]; ++i)
+                u[at(k, j, i)] = std::sin(i * g) * std::cos(2 * j * g) * std::exp(k * g / 2);
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        GridDifference<1, 3>::apply(u.data(), extents, axis, g, du.data());
+        for (std::size_t k = 0; k < extents[0]; ++k)
+            for (std::size_t j = 0; j < extents[1]; ++j)
+                for (std::size_t i = 0; i < extents[2]; ++i) {
+                    const double x = i * g, y = j * g, z = k * g;
+                    const double exact = axis == 2 ? std::cos(x) * std::cos(2 * y) * std::exp(z / 2)
+                                       : axis == 1 ? -2 * std::sin(x) * std::sin(2 * y) * std::exp(z / 2)
+                                                   : 0.5 * std::sin(x) * std::cos(2 * y) * std::exp(z / 2);
+                    assert(std::fabs(du[at(k, j, i)] - exact) < 1e-9);
+                }
+    }
+
+    // Adaptive step: accurate without choosing h, within the evaluation cap
+    auto counted = 0;
+    auto expo = [&](double t) { ++counted; return std::exp(t); };
+    auto adaptive = adaptive_derivative(expo, 1.0, 0.5);
+    std::cout << "Ridders f'(1): " << adaptive.value << " +/- " << adaptive.error
+              << " (" << adaptive.evaluations << " evaluations)\n";
+    assert(std::fabs(adaptive.value - std::exp(1.0)) < 1e-12);
+    assert(adaptive.error < 1e-10 && std::fabs(adaptive.value - std::exp(1.0)) <= 10 * adaptive.error + 1e-15);
+    assert(adaptive.evaluations <= 40 && static_cast<std::size_t>(counted) == adaptive.evaluations);
+
+    auto second = adaptive_derivative<2>(expo, 0.0, 0.5, 30);
+    assert(std::fabs(second.value - 1.0) < 1e-8 && second.evaluations <= 30);
+
+    // A loose tolerance stops early
+    auto loose = adaptive_derivative(expo, 1.0, 0.5, 40, 1e-4);
+    assert(loose.evaluations < adaptive.evaluations && std::fabs(loose.value - std::exp(1.0)) < 1e-4);
+
+    // Jacobians: F(x) = (x0^2 x1, 5 x0 + sin x1, exp(x1) / x0)
+    auto system = [](const auto& v) {
+        using std::sin; using std::exp;
+        using S = typename std::decay_t<decltype(v)>::value_type;
+        return std::vector<S>{v[0] * v[0] * v[1], S(5) * v[0] + sin(v[1]), exp(v[1]) / v[0]};
+    };
+    const std::vector<double> p{1.3, -0.4};
+    const double exact_jac[6] = {2 * p[0] * p[1], p[0] * p[0], 5.0, std::cos(p[1]),
+                                 -std::exp(p[1]) / (p[0] * p[0]), std::exp(p[1]) / p[0]};
+    auto forward = fd_jacobian(system, p, JacobianMethod::Forward);
+    auto centered = fd_jacobian(system, p);
+    auto complex_step = fd_jacobian(system, p, JacobianMethod::ComplexStep);
+    for (int k = 0; k < 6; ++k) {
+        assert(std::fabs(forward[k] - exact_jac[k]) < 1e-6);
+        assert(std::fabs(centered[k] - exact_jac[k]) < 1e-9);
+        assert(std::fabs(complex_step[k] - exact_jac[k]) < 1e-14);
+    }
+    assert(std::fabs(complex_step_derivative([](auto t) { return std::exp(t) * std::sin(t); }, 0.5)
+                     - std::exp(0.5) * (std::sin(0.5) + std::cos(0.5))) < 1e-15);
+
+    auto rosenbrock = [](const auto& v) { return (1.0 - v[0]) * (1.0 - v[0]) + 100.0 * (v[1] - v[0] * v[0]) * (v[1] - v[0] * v[0]); };
+    auto grad = fd_gradient(rosenbrock, std::vector<double>{0.5, 0.5}, JacobianMethod::ComplexStep);
+    assert(std::fabs(grad[0] + 51.0) < 1e-12 && std::fabs(grad[1] - 50.0) < 1e-12);
+    // A callable taking only real vectors works with the real methods
+    auto real_only = [](const std::vector<double>& v) { return v[0] * v[0] + 3.0 * v[1]; };
+    auto real_grad = fd_gradient(real_only, std::vector<double>{2.0, -1.0});
+    assert(std::fabs(real_grad[0] - 4.0) < 1e-9 && std::fabs(real_grad[1] - 3.0) < 1e-9);
+
+    // Tridiagonal system: 3 colors whatever the size
+    const std::size_t dim = 50;
+    auto chain = [dim](const auto& v) {
+        using S = typename std::decay_t<decltype(v)>::value_type;
+        std::vector<S> r(dim);
+        for (std::size_t i = 0; i < dim; ++i) {
+            r[i] = (3.0 - 2.0 * v[i]) * v[i] + 1.0;
+            if (i > 0) r[i] -= v[i - 1];
+            if (i + 1 < dim) r[i] -= 2.0 * v[i + 1];
+        }
+        return r;
+    };
+    JacobianPattern tridiagonal{dim, dim, std::vector<std::vector<std::size_t>>(dim)};
+    for (std::size_t i = 0; i < dim; ++i)
+        for (std::size_t j = (i > 0 ? i - 1 : 0); j <= std::min(i + 1, dim - 1); ++j) tridiagonal.nonzeros[i].push_back(j);
+    auto chain_colors = color_jacobian_columns(tridiagonal);
+    assert(*std::max_element(chain_colors.begin(), chain_colors.end()) == 2);
+    std::vector<double> z(dim);
+    for (std::size_t i = 0; i < dim; ++i) z[i] = std::cos(0.3 * i);
+    auto dense = fd_jacobian(chain, z, JacobianMethod::ComplexStep);
+    auto sparse = fd_jacobian(chain, z, tridiagonal, JacobianMethod::ComplexStep);
+    auto sparse_centered = fd_jacobian(chain, z, tridiagonal);
+    for (std::size_t k = 0; k < dim * dim; ++k) {
+        assert(std::fabs(sparse[k] - dense[k]) < 1e-14);
+        assert(std::fabs(sparse_centered[k] - dense[k]) < 1e-8);
+    }
 }
@@ -0,0 +1,38 @@
+// Compiles the headers written by codegen_example at build time and checks
+// them against the closed forms
+#include "codegen_functions.h"
+#include "generated_scalar.h"
+#include "generated_system.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+int main() {
+    auto near = [](double a, double b) { return std::fabs(a - b) <= 1e-12 * (1.0 + std::fabs(b)); };
+
+    for (double x = -1.5; x <= 1.5; x += 0.25) {
+        for (double y = 0.25; y <= 2.0; y += 0.25) {
+            const double point[2] = {x, y};
+            double grad[2], expected[2], fused[2];
+            const double value = codegen_example::scalar_exact(x, y, expected);
+            assert(near(generated::scalar(point), value));
+            generated::scalar_gradient(point, grad);
+            assert(near(grad[0], expected[0]) && near(grad[1], expected[1]));
+            assert(near(generated::scalar_value_and_gradient(point, fused), value));
+            assert(near(fused[0], expected[0]) && near(fused[1], expected[1]));
+        }
+    }
+
+    const double point[3] = {0.8, 1.7, -0.4};
+    double f[3], jac[9], f_exact[3], jac_exact[9], f_fused[3], jac_fused[9];
+    codegen_example::system_exact(point, f_exact, jac_exact);
+    generated::system(point, f);
+    generated::system_jacobian(point, jac);
+    generated::system_value_and_jacobian(point, f_fused, jac_fused);
+    for (int i = 0; i < 3; ++i) assert(near(f[i], f_exact[i]) && near(f_fused[i], f_exact[i]));
+    for (int k = 0; k < 9; ++k) assert(near(jac[k], jac_exact[k]) && near(jac_fused[k], jac_exact[k]));
+
+    std::cout << "Código generado verificado" << std::endl;
+    return 0;
+}
@@ -0,0 +1,21 @@
+// Writes the generated headers used by codegen_check.cpp:
+//   codegen_example <output directory>
+#include "codegen_functions.h"
+#include "symbolic_codegen.h"
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <output directory>" << std::endl;
+        return 1;
+    }
+    const std::string dir = argv[1];
+
+    std::ofstream(dir + "/generated_scalar.h")
+        << symbolic::generate_header("scalar", codegen_example::scalar(), {"x", "y"});
+    std::ofstream(dir + "/generated_system.h")
+        << symbolic::generate_jacobian_header("system", codegen_example::system(), {"x", "y", "z"});
+    return 0;
+}
@@ -0,0 +1,50 @@
+#ifndef CODEGEN_FUNCTIONS_H
+#define CODEGEN_FUNCTIONS_H
+
+#include "symbolic_diff.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// The functions generated by codegen_example and their closed forms,
+// which codegen_check compares the generated code against
+namespace codegen_example {
+
+// f(x, y) = exp(x y) / (1 + x^2) + log(y) x^3 - sin(x) cos(y)
+inline std::shared_ptr<symbolic::Expression> scalar() {
+    using namespace symbolic;
+    auto x = make_variable("x"), y = make_variable("y");
+    return exp(x * y) / (make_constant(1.0) + x * x) + log(y) * pow(x, 3.0) - sin(x) * cos(y);
+}
+
+inline double scalar_exact(double x, double y, double grad[2]) {
+    const double e = std::exp(x * y), d = 1.0 + x * x;
+    grad[0] = y * e / d - 2.0 * x * e / (d * d) + 3.0 * std::log(y) * x * x - std::cos(x) * std::cos(y);
+    grad[1] = x * e / d + x * x * x / y + std::sin(x) * std::sin(y);
+    return e / d + std::log(y) * x * x * x - std::sin(x) * std::cos(y);
+}
+
+// F(x, y, z) = (x y z - 1, exp(x) + log(y) - z / (x + 2), x^y)
+inline std::vector<std::shared_ptr<symbolic::Expression>> system() {
+    using namespace symbolic;
+    auto x = make_variable("x"), y = make_variable("y"), z = make_variable("z");
+    return {x * y * z - make_constant(1.0),
+            exp(x) + log(y) - z / (x + make_constant(2.0)),
+            pow(x, y)};
+}
+
+inline void system_exact(const double* v, double f[3], double jac[9]) {
+    const double x = v[0], y = v[1], z = v[2];
+    f[0] = x * y * z - 1.0;
+    f[1] = std::exp(x) + std::log(y) - z / (x + 2.0);
+    f[2] = std::pow(x, y);
+    const double rows[9] = {y * z, x * z, x * y,
+                            std::exp(x) + z / ((x + 2.0) * (x + 2.0)), 1.0 / y, -1.0 / (x + 2.0),
+                            y * std::pow(x, y - 1.0), std::pow(x, y) * std::log(x), 0.0};
+    for (int k = 0; k < 9; ++k) jac[k] = rows[k];
+}
+
+}
+
+#endif // CODEGEN_FUNCTIONS_H
@@ -1,5 +1,11 @@
 #include "symbolic_diff.h"
+#include "symbolic_eval.h"
+#include "symbolic_codegen.h"
 #include <iostream>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <vector>
 
 int main() {
     using namespace symbolic;
@@ -17,5 +23,100 @@ int main() {
     auto deriv_simp = deriv->simplify();
     std::cout << "Derivada simplificada: " << deriv_simp->to_string() << std::endl;
 
+    // Structurally equal expressions are the same node
+    assert(x * x == x_squared);
+    assert(make_variable("x") == x);
+    assert(make_constant(2.0) == make_constant(2.0));
+    assert(deriv_simp == (x + x) + cos(x));
+
+    // Memoized: differentiating again returns the same node
+    assert(expr->derivative("x") == deriv);
+    assert(expr->derivative("y")->simplify() == make_constant(0.0));
+
+    // Constant folding on values
+    auto folded = ((make_constant(2.0) + make_constant(3.5)) * x + make_constant(0.0) * sin_x)->simplify();
+    assert(folded == make_constant(5.5) * x);
+    assert((sin(make_constant(0.0)) + cos(make_constant(0.0)))->simplify() == make_constant(1.0));
+
+    // Repeated differentiation: every derivative shares the subtrees of the
+    // previous ones, so the store grows by a bounded amount per order
+    auto y = make_variable("y");
+    auto f = sin(x * y) * cos(x);
+    std::size_t before = ExpressionStore::global().size();
+    for (int order = 0; order < 12; ++order) {
+        f = f->derivative("x")->simplify();
+    }
+    std::size_t grown = ExpressionStore::global().size() - before;
+    std::cout << "Nodos tras 12 derivadas: " << grown << std::endl;
+    assert(grown < 5000);
+
+    // Compiled evaluation of a function and its partial derivatives
+    auto g = sin(x * y) * cos(x) + make_constant(3.0) * x * x;
+    auto gx = g->derivative("x")->simplify();
+    auto gy = g->derivative("y")->simplify();
+    CompiledExpression program({g, gx, gy}, {"x", "y"});
+    std::cout << "Instrucciones: " << program.instructions().size()
+              << ", registros: " << program.num_registers() << std::endl;
+
+    auto exact = [](double xv, double yv, double out[3]) {
+        out[0] = std::sin(xv * yv) * std::cos(xv) + 3.0 * xv * xv;
+        out[1] = yv * std::cos(xv * yv) * std::cos(xv) - std::sin(xv * yv) * std::sin(xv) + 6.0 * xv;
+        out[2] = xv * std::cos(xv * yv) * std::cos(xv);
+    };
+    auto near = [](double a, double b) { return std::fabs(a - b) <= 1e-12 * (1.0 + std::fabs(b)); };
+
+    double point[2] = {0.7, -1.2}, values[3], expected[3];
+    program.evaluate(point, values);
+    exact(point[0], point[1], expected);
+    for (int o = 0; o < 3; ++o) assert(near(values[o], expected[o]));
+    assert(near(CompiledExpression(gx, {"x", "y"}).evaluate(point), expected[1]));
+
+    // Batched over a grid that is not a multiple of the block size
+    const std::size_t count = 1000;
+    std::vector<double> grid(2 * count), out(3 * count);
+    for (std::size_t p = 0; p < count; ++p) {
+        grid[p] = -2.0 + 4.0 * p / count;
+        grid[count + p] = std::cos(0.01 * p);
+    }
+    program.evaluate_batch(grid.data(), count, out.data());
+    for (std::size_t p = 0; p < count; ++p) {
+        exact(grid[p], grid[count + p], expected);
+        for (int o = 0; o < 3; ++o) assert(near(out[o * count + p], expected[o]));
+    }
+
+    // Constant and variable outputs need no instructions
+    CompiledExpression trivial({make_constant(2.5), y}, {"x", "y"});
+    trivial.evaluate(point, values);
+    assert(values[0] == 2.5 && values[1] == point[1]);
+
+    // Quotients, powers, exp and log
+    auto h = exp(x) / y + log(x * y) - pow(x, 2.0) + pow(y, x);
+    auto hx = h->derivative("x")->simplify();
+    auto hy = h->derivative("y")->simplify();
+    assert(log(exp(x))->simplify() == x);
+    assert(pow(x, 1.0)->simplify() == x && pow(x, 0.0)->simplify() == make_constant(1.0));
+    assert((x / x)->simplify() == make_constant(1.0));
+    CompiledExpression h_program({h, hx, hy}, {"x", "y"});
+    const double q[2] = {0.9, 1.6};
+    h_program.evaluate(q, values);
+    assert(near(values[0], std::exp(q[0]) / q[1] + std::log(q[0] * q[1]) - q[0] * q[0] + std::pow(q[1], q[0])));
+    assert(near(values[1], std::exp(q[0]) / q[1] + 1.0 / q[0] - 2.0 * q[0] + std::pow(q[1], q[0]) * std::log(q[1])));
+    assert(near(values[2], -std::exp(q[0]) / (q[1] * q[1]) + 1.0 / q[1] + q[0] * std::pow(q[1], q[0] - 1.0)));
+
+    // Generated code: shared nodes become one temporary
+    auto shared = sin(x * y);
+    std::string code = generate_function("f", {shared * shared, shared + x}, {"x", "y"});
+    std::cout << code;
+    assert(code.find("const double t0 = std::sin(x[0] * x[1]);") != std::string::npos);
+    assert(code.find("out[0] = t0 * t0;") != std::string::npos);
+    assert(code.find("out[1] = t0 + x[0];") != std::string::npos);
+    assert(code.find("t1") == std::string::npos);
+
+    // Non-finite constants from folding still compile
+    std::string non_finite = generate_function("g", {(log(make_constant(0.0)) * x)->simplify(), make_constant(std::nan(""))}, {"x"});
+    std::cout << non_finite;
+    assert(non_finite.find("std::numeric_limits<double>::infinity()") != std::string::npos);
+    assert(non_finite.find("std::numeric_limits<double>::quiet_NaN()") != std::string::npos);
+
     return 0;
-}
\ No newline at end of file
+}
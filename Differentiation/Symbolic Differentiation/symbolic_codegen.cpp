@@ -0,0 +1,251 @@
+#include "symbolic_codegen.h"
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace symbolic {
+
+namespace {
+
+std::string literal(double value) {
+    // Constant folding can produce these (log(0), 0 / 0); %g would print inf / nan
+    if (std::isnan(value)) return "std::numeric_limits<double>::quiet_NaN()";
+    if (std::isinf(value)) {
+        return value > 0 ? "std::numeric_limits<double>::infinity()"
+                         : "(-std::numeric_limits<double>::infinity())";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof buffer, "%.17g", value);
+    std::string text = buffer;
+    if (text.find_first_of(".eEn") == std::string::npos) {
+        text += ".0";   // keep it a double literal
+    }
+    return value < 0 ? "(" + text + ")" : text;
+}
+
+bool is_minus_one(const Expression* e) {
+    return e->kind() == Kind::Constant && static_cast<const Constant*>(e)->value() == -1.0;
+}
+
+// Emits statements computing outputs into the given lvalues
+class BodyWriter {
+public:
+    BodyWriter(const std::vector<std::string>& variables) {
+        for (std::size_t v = 0; v < variables.size(); ++v) {
+            variable_index_.emplace(variables[v], v);
+        }
+    }
+
+    void write(std::ostream& out, const std::vector<std::shared_ptr<Expression>>& outputs,
+               const std::vector<std::string>& targets, const std::string& indent) {
+        // Distinct nodes in topological order and how often each is read
+        std::vector<const Expression*> order;
+        std::unordered_map<const Expression*, int> uses;
+        for (const auto& root : outputs) {
+            ++uses[root.get()];
+            std::vector<std::pair<const Expression*, bool>> stack{{root.get(), false}};
+            while (!stack.empty()) {
+                auto [e, expanded] = stack.back();
+                stack.pop_back();
+                if (expanded) {
+                    order.push_back(e);
+                    continue;
+                }
+                if (seen_.count(e)) continue;
+                seen_.insert(e);
+                stack.push_back({e, true});
+                for (std::size_t i = e->arity(); i-- > 0;) {
+                    const Expression* child = e->operand(i).get();
+                    ++uses[child];
+                    stack.push_back({child, false});
+                }
+            }
+        }
+
+        for (const Expression* e : order) {
+            std::string text = expression_text(e);
+            if (e->arity() > 0 && uses[e] > 1) {
+                const std::string name = "t" + std::to_string(temporaries_++);
+                out << indent << "const double " << name << " = " << strip_parens(text) << ";\n";
+                text = name;
+                temporary_.insert(e);
+            }
+            text_.emplace(e, text);
+        }
+        for (std::size_t o = 0; o < outputs.size(); ++o) {
+            out << indent << targets[o] << " = " << strip_parens(text_.at(outputs[o].get())) << ";\n";
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::size_t> variable_index_;
+    std::unordered_set<const Expression*> seen_;
+    std::unordered_set<const Expression*> temporary_;
+    std::unordered_map<const Expression*, std::string> text_;
+    int temporaries_ = 0;
+
+    static std::string strip_parens(const std::string& s) {
+        if (s.size() < 2 || s.front() != '(' || s.back() != ')') return s;
+        int depth = 0;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            if (s[i] == '(') ++depth;
+            if (s[i] == ')' && --depth == 0 && i + 1 != s.size()) return s;   // (a) + (b)
+        }
+        return s.substr(1, s.size() - 2);
+    }
+
+    std::string expression_text(const Expression* e) const {
+        switch (e->kind()) {
+            case Kind::Constant:
+                return literal(static_cast<const Constant*>(e)->value());
+            case Kind::Variable: {
+                const auto& name = static_cast<const Variable*>(e)->name();
+                const auto it = variable_index_.find(name);
+                if (it == variable_index_.end()) {
+                    throw std::invalid_argument("generate: unknown variable " + name);
+                }
+                return "x[" + std::to_string(it->second) + "]";
+            }
+            default:
+                break;
+        }
+
+        const std::string a = text_.at(e->operand(0).get());
+        switch (e->kind()) {
+            case Kind::Sum: {
+                const Expression* right = e->operand(1).get();
+                // f + (-1) * g is how subtraction is stored
+                if (right->kind() == Kind::Product && is_minus_one(right->operand(0).get()) &&
+                    !temporary_.count(right)) {
+                    return "(" + a + " - " + text_.at(right->operand(1).get()) + ")";
+                }
+                return "(" + a + " + " + text_.at(right) + ")";
+            }
+            case Kind::Product:
+                if (is_minus_one(e->operand(0).get())) {
+                    return "(-" + text_.at(e->operand(1).get()) + ")";
+                }
+                return "(" + a + " * " + text_.at(e->operand(1).get()) + ")";
+            case Kind::Quotient: return "(" + a + " / " + text_.at(e->operand(1).get()) + ")";
+            case Kind::Power: return "std::pow(" + strip_parens(a) + ", " + strip_parens(text_.at(e->operand(1).get())) + ")";
+            case Kind::Sine: return "std::sin(" + strip_parens(a) + ")";
+            case Kind::Cosine: return "std::cos(" + strip_parens(a) + ")";
+            case Kind::Exponential: return "std::exp(" + strip_parens(a) + ")";
+            case Kind::Logarithm: return "std::log(" + strip_parens(a) + ")";
+            default: throw std::invalid_argument("generate: unsupported expression kind");
+        }
+    }
+};
+
+std::vector<std::shared_ptr<Expression>> gradient_of(const std::shared_ptr<Expression>& f,
+                                                     const std::vector<std::string>& variables) {
+    std::vector<std::shared_ptr<Expression>> grad;
+    for (const auto& v : variables) {
+        grad.push_back(f->derivative(v)->simplify());
+    }
+    return grad;
+}
+
+std::string variable_comment(const std::vector<std::string>& variables) {
+    std::string text = "// Inputs:";
+    for (std::size_t v = 0; v < variables.size(); ++v) {
+        text += " x[" + std::to_string(v) + "] = " + variables[v] + (v + 1 < variables.size() ? "," : "");
+    }
+    return text + "\n";
+}
+
+std::vector<std::string> indexed(const std::string& array, std::size_t count) {
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < count; ++i) names.push_back(array + "[" + std::to_string(i) + "]");
+    return names;
+}
+
+void open_header(std::ostream& out, const std::string& namespace_name, const std::vector<std::string>& variables) {
+    out << "// Generated by symbolic::generate_header; do not edit.\n"
+        << "#pragma once\n\n#include <cmath>\n#include <limits>\n\n"
+        << "namespace " << namespace_name << " {\n\n"
+        << variable_comment(variables) << "\n";
+}
+
+}
+
+std::string generate_function(const std::string& name,
+                              const std::vector<std::shared_ptr<Expression>>& outputs,
+                              const std::vector<std::string>& variables) {
+    std::ostringstream out;
+    out << "inline void " << name << "(const double* x, double* out) {\n";
+    BodyWriter(variables).write(out, outputs, indexed("out", outputs.size()), "    ");
+    out << "}\n";
+    return out.str();
+}
+
+std::string generate_header(const std::string& name, const std::shared_ptr<Expression>& f,
+                            const std::vector<std::string>& variables, const std::string& namespace_name) {
+    const auto grad = gradient_of(f, variables);
+    std::vector<std::shared_ptr<Expression>> both{f};
+    both.insert(both.end(), grad.begin(), grad.end());
+    std::vector<std::string> both_targets{"value"};
+    const auto grad_targets = indexed("grad", grad.size());
+    both_targets.insert(both_targets.end(), grad_targets.begin(), grad_targets.end());
+
+    std::ostringstream out;
+    open_header(out, namespace_name, variables);
+
+    out << "// " << f->to_string() << "\n"
+        << "inline double " << name << "(const double* x) {\n    double value;\n";
+    BodyWriter(variables).write(out, {f}, {"value"}, "    ");
+    out << "    return value;\n}\n\n";
+
+    out << "inline void " << name << "_gradient(const double* x, double* grad) {\n";
+    BodyWriter(variables).write(out, grad, grad_targets, "    ");
+    out << "}\n\n";
+
+    out << "inline double " << name << "_value_and_gradient(const double* x, double* grad) {\n    double value;\n";
+    BodyWriter(variables).write(out, both, both_targets, "    ");
+    out << "    return value;\n}\n\n";
+
+    out << "}\n";
+    return out.str();
+}
+
+std::string generate_jacobian_header(const std::string& name,
+                                     const std::vector<std::shared_ptr<Expression>>& f,
+                                     const std::vector<std::string>& variables,
+                                     const std::string& namespace_name) {
+    const std::size_t n = variables.size();
+    std::vector<std::shared_ptr<Expression>> jac;
+    for (const auto& fi : f) {
+        const auto row = gradient_of(fi, variables);
+        jac.insert(jac.end(), row.begin(), row.end());
+    }
+    std::vector<std::shared_ptr<Expression>> both = f;
+    both.insert(both.end(), jac.begin(), jac.end());
+    std::vector<std::string> both_targets = indexed("f", f.size());
+    const auto jac_targets = indexed("jac", f.size() * n);
+    both_targets.insert(both_targets.end(), jac_targets.begin(), jac_targets.end());
+
+    std::ostringstream out;
+    open_header(out, namespace_name, variables);
+
+    out << "inline void " << name << "(const double* x, double* f) {\n";
+    BodyWriter(variables).write(out, f, indexed("f", f.size()), "    ");
+    out << "}\n\n";
+
+    out << "// jac[i * " << n << " + j] = df_i/dx_j\n"
+        << "inline void " << name << "_jacobian(const double* x, double* jac) {\n";
+    BodyWriter(variables).write(out, jac, jac_targets, "    ");
+    out << "}\n\n";
+
+    out << "inline void " << name << "_value_and_jacobian(const double* x, double* f, double* jac) {\n";
+    BodyWriter(variables).write(out, both, both_targets, "    ");
+    out << "}\n\n";
+
+    out << "}\n";
+    return out.str();
+}
+
+}
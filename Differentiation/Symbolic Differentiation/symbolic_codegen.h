@@ -0,0 +1,48 @@
+#ifndef SYMBOLIC_CODEGEN_H
+#define SYMBOLIC_CODEGEN_H
+
+#include "symbolic_diff.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace symbolic {
+
+// C++ source generation from expression DAGs.
+//
+// The generated functions are straight-line code over const double
+// temporaries: every node of the DAG used more than once (across all the
+// outputs of a function, so a value and its derivatives share work)
+// becomes one temporary, and single-use nodes are inlined into the
+// expression that reads them. Inputs are read from x[i] in the order of
+// the variables list. Derivatives are simplified before generation.
+// Non-finite constants are written as std::numeric_limits<double>
+// expressions, so code from generate_function needs <cmath> and <limits>
+// (the generated headers include both).
+
+// inline void <name>(const double* x, double* out), out[o] = outputs[o](x)
+std::string generate_function(const std::string& name,
+                              const std::vector<std::shared_ptr<Expression>>& outputs,
+                              const std::vector<std::string>& variables);
+
+// Header for a scalar function with
+//   double <name>(const double* x)
+//   void <name>_gradient(const double* x, double* grad)
+//   double <name>_value_and_gradient(const double* x, double* grad)
+std::string generate_header(const std::string& name, const std::shared_ptr<Expression>& f,
+                            const std::vector<std::string>& variables,
+                            const std::string& namespace_name = "generated");
+
+// Header for a vector function f: R^n -> R^m with
+//   void <name>(const double* x, double* f)
+//   void <name>_jacobian(const double* x, double* jac)       jac[i * n + j] = df_i/dx_j
+//   void <name>_value_and_jacobian(const double* x, double* f, double* jac)
+std::string generate_jacobian_header(const std::string& name,
+                                     const std::vector<std::shared_ptr<Expression>>& f,
+                                     const std::vector<std::string>& variables,
+                                     const std::string& namespace_name = "generated");
+
+}
+
+#endif // SYMBOLIC_CODEGEN_H
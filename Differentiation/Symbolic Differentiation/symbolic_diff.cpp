@@ -1,122 +1,418 @@
 #include "symbolic_diff.h"
 #include <sstream>
+#include <stdexcept>
 
 namespace symbolic {
 
+namespace {
+
+bool is_constant(const std::shared_ptr<Expression>& e, double value) {
+    return e->kind() == Kind::Constant && static_cast<const Constant&>(*e).value() == value;
+}
+
+double constant_value(const std::shared_ptr<Expression>& e) {
+    return static_cast<const Constant&>(*e).value();
+}
+
+}
+
+// Memoized entry points
+
+std::shared_ptr<Expression> Expression::derivative(const std::string& var) const {
+    ExpressionStore& store = ExpressionStore::global();
+    if (auto cached = store.find_derivative(this, var)) {
+        return cached;
+    }
+    auto result = compute_derivative(var);
+    // Nodes not owned by a shared_ptr (e.g. on the stack) are not memoized
+    if (auto self = weak_from_this().lock()) {
+        store.store_derivative(self, var, result);
+    }
+    return result;
+}
+
+std::shared_ptr<Expression> Expression::simplify() const {
+    ExpressionStore& store = ExpressionStore::global();
+    if (auto cached = store.find_simplified(this)) {
+        return cached;
+    }
+    auto result = compute_simplify();
+    if (auto self = weak_from_this().lock()) {
+        store.store_simplified(self, result);
+    }
+    return result;
+}
+
+const std::shared_ptr<Expression>& Expression::operand(std::size_t) const {
+    throw std::out_of_range("expression has no operands");
+}
+
 std::string Constant::to_string() const {
     std::stringstream ss;
     ss << value_;
     return ss.str();
 }
 
-std::shared_ptr<Expression> Constant::derivative(const std::string& /*var*/) const {
-    return std::make_shared<Constant>(0.0); 
+std::shared_ptr<Expression> Constant::compute_derivative(const std::string& /*var*/) const {
+    return make_constant(0.0);
 }
 
-std::shared_ptr<Expression> Constant::simplify() const {
-    return std::make_shared<Constant>(value_);
+std::shared_ptr<Expression> Constant::compute_simplify() const {
+    return make_constant(value_);
 }
 
 std::string Variable::to_string() const {
     return name_;
 }
 
-std::shared_ptr<Expression> Variable::derivative(const std::string& var) const {
-    return std::make_shared<Constant>(name_ == var ? 1.0 : 0.0);
+std::shared_ptr<Expression> Variable::compute_derivative(const std::string& var) const {
+    return make_constant(name_ == var ? 1.0 : 0.0);
 }
 
-std::shared_ptr<Expression> Variable::simplify() const {
-    return std::make_shared<Variable>(name_);
+std::shared_ptr<Expression> Variable::compute_simplify() const {
+    return make_variable(name_);
 }
 
 std::string Sum::to_string() const {
     return "(" + left_->to_string() + " + " + right_->to_string() + ")";
 }
 
-std::shared_ptr<Expression> Sum::derivative(const std::string& var) const {
-    return std::make_shared<Sum>(left_->derivative(var), right_->derivative(var)); // (f + g)' = f' + g'
+std::shared_ptr<Expression> Sum::compute_derivative(const std::string& var) const {
+    return left_->derivative(var) + right_->derivative(var); // (f + g)' = f' + g'
 }
 
-std::shared_ptr<Expression> Sum::simplify() const {
+std::shared_ptr<Expression> Sum::compute_simplify() const {
     auto left_simp = left_->simplify();
     auto right_simp = right_->simplify();
-    if (auto left_const = std::dynamic_pointer_cast<Constant>(left_simp)) {
-        if (auto right_const = std::dynamic_pointer_cast<Constant>(right_simp)) {
-            return std::make_shared<Constant>(left_const->to_string() == "0" ? right_const->to_string() == "0" ? 0.0 : right_const->to_string() == "0" ? left_const->to_string() : left_const->to_string() == "0" ? right_const->to_string() : std::stod(left_const->to_string()) + std::stod(right_const->to_string()));
-        }
+    if (left_simp->kind() == Kind::Constant && right_simp->kind() == Kind::Constant) {
+        return make_constant(constant_value(left_simp) + constant_value(right_simp));
+    }
+    if (is_constant(left_simp, 0.0)) {
+        return right_simp;
     }
-    return std::make_shared<Sum>(left_simp, right_simp);
+    if (is_constant(right_simp, 0.0)) {
+        return left_simp;
+    }
+    return left_simp + right_simp;
 }
 
 std::string Product::to_string() const {
     return "(" + left_->to_string() + " * " + right_->to_string() + ")";
 }
 
-std::shared_ptr<Expression> Product::derivative(const std::string& var) const {
+std::shared_ptr<Expression> Product::compute_derivative(const std::string& var) const {
     // (f * g)' = f' * g + f * g'
-    return std::make_shared<Sum>(
-        std::make_shared<Product>(left_->derivative(var), right_),
-        std::make_shared<Product>(left_, right_->derivative(var))
-    );
+    return left_->derivative(var) * right_ + left_ * right_->derivative(var);
 }
 
-std::shared_ptr<Expression> Product::simplify() const {
+std::shared_ptr<Expression> Product::compute_simplify() const {
     auto left_simp = left_->simplify();
     auto right_simp = right_->simplify();
-    if (auto left_const = std::dynamic_pointer_cast<Constant>(left_simp)) {
-        if (left_const->to_string() == "0") {
-            return std::make_shared<Constant>(0.0); 
-        }
-        if (left_const->to_string() == "1") {
-            return right_simp; 
-        }
+    if (left_simp->kind() == Kind::Constant && right_simp->kind() == Kind::Constant) {
+        return make_constant(constant_value(left_simp) * constant_value(right_simp));
+    }
+    if (is_constant(left_simp, 0.0) || is_constant(right_simp, 0.0)) {
+        return make_constant(0.0);
+    }
+    if (is_constant(left_simp, 1.0)) {
+        return right_simp;
     }
-    if (auto right_const = std::dynamic_pointer_cast<Constant>(right_simp)) {
-        if (right_const->to_string() == "0") {
-            return std::make_shared<Constant>(0.0);
-        }
-        if (right_const->to_string() == "1") {
-            return left_simp;
-        }
+    if (is_constant(right_simp, 1.0)) {
+        return left_simp;
     }
-    return std::make_shared<Product>(left_simp, right_simp);
+    return left_simp * right_simp;
 }
 
 std::string Sine::to_string() const {
     return "sin(" + arg_->to_string() + ")";
 }
 
-std::shared_ptr<Expression> Sine::derivative(const std::string& var) const {
+std::shared_ptr<Expression> Sine::compute_derivative(const std::string& var) const {
     // (sin(u))' = cos(u) * u'
-    return std::make_shared<Product>(
-        std::make_shared<Sine>(arg_),
-        arg_->derivative(var)
-    );
+    return cos(arg_) * arg_->derivative(var);
 }
 
-std::shared_ptr<Expression> Sine::simplify() const {
-    return std::make_shared<Sine>(arg_->simplify());
+std::shared_ptr<Expression> Sine::compute_simplify() const {
+    auto arg_simp = arg_->simplify();
+    if (arg_simp->kind() == Kind::Constant) {
+        return make_constant(std::sin(constant_value(arg_simp)));
+    }
+    return sin(arg_simp);
+}
+
+std::string Cosine::to_string() const {
+    return "cos(" + arg_->to_string() + ")";
+}
+
+std::shared_ptr<Expression> Cosine::compute_derivative(const std::string& var) const {
+    // (cos(u))' = -sin(u) * u'
+    return make_constant(-1.0) * (sin(arg_) * arg_->derivative(var));
+}
+
+std::shared_ptr<Expression> Cosine::compute_simplify() const {
+    auto arg_simp = arg_->simplify();
+    if (arg_simp->kind() == Kind::Constant) {
+        return make_constant(std::cos(constant_value(arg_simp)));
+    }
+    return cos(arg_simp);
+}
+
+std::string Quotient::to_string() const {
+    return "(" + left_->to_string() + " / " + right_->to_string() + ")";
+}
+
+std::shared_ptr<Expression> Quotient::compute_derivative(const std::string& var) const {
+    // (f / g)' = (f' g - f g') / g^2
+    return (left_->derivative(var) * right_ - left_ * right_->derivative(var)) / (right_ * right_);
+}
+
+std::shared_ptr<Expression> Quotient::compute_simplify() const {
+    auto left_simp = left_->simplify();
+    auto right_simp = right_->simplify();
+    if (left_simp->kind() == Kind::Constant && right_simp->kind() == Kind::Constant) {
+        return make_constant(constant_value(left_simp) / constant_value(right_simp));
+    }
+    if (is_constant(left_simp, 0.0)) {
+        return make_constant(0.0);
+    }
+    if (is_constant(right_simp, 1.0)) {
+        return left_simp;
+    }
+    if (left_simp == right_simp) {
+        return make_constant(1.0);
+    }
+    return left_simp / right_simp;
+}
+
+std::string Power::to_string() const {
+    return "pow(" + left_->to_string() + ", " + right_->to_string() + ")";
+}
+
+std::shared_ptr<Expression> Power::compute_derivative(const std::string& var) const {
+    if (right_->kind() == Kind::Constant) {
+        // (u^c)' = c u^(c-1) u'
+        const double c = constant_value(right_);
+        return make_constant(c) * pow(left_, c - 1.0) * left_->derivative(var);
+    }
+    // (u^v)' = u^v (v' log(u) + v u' / u)
+    return pow(left_, right_) *
+           (right_->derivative(var) * log(left_) + right_ * left_->derivative(var) / left_);
+}
+
+std::shared_ptr<Expression> Power::compute_simplify() const {
+    auto left_simp = left_->simplify();
+    auto right_simp = right_->simplify();
+    if (left_simp->kind() == Kind::Constant && right_simp->kind() == Kind::Constant) {
+        return make_constant(std::pow(constant_value(left_simp), constant_value(right_simp)));
+    }
+    if (is_constant(right_simp, 0.0)) {
+        return make_constant(1.0);
+    }
+    if (is_constant(right_simp, 1.0)) {
+        return left_simp;
+    }
+    return pow(left_simp, right_simp);
+}
+
+std::string Exponential::to_string() const {
+    return "exp(" + arg_->to_string() + ")";
+}
+
+std::shared_ptr<Expression> Exponential::compute_derivative(const std::string& var) const {
+    // (exp(u))' = exp(u) * u'
+    return exp(arg_) * arg_->derivative(var);
+}
+
+std::shared_ptr<Expression> Exponential::compute_simplify() const {
+    auto arg_simp = arg_->simplify();
+    if (arg_simp->kind() == Kind::Constant) {
+        return make_constant(std::exp(constant_value(arg_simp)));
+    }
+    return exp(arg_simp);
+}
+
+std::string Logarithm::to_string() const {
+    return "log(" + arg_->to_string() + ")";
+}
+
+std::shared_ptr<Expression> Logarithm::compute_derivative(const std::string& var) const {
+    // (log(u))' = u' / u
+    return arg_->derivative(var) / arg_;
+}
+
+std::shared_ptr<Expression> Logarithm::compute_simplify() const {
+    auto arg_simp = arg_->simplify();
+    if (arg_simp->kind() == Kind::Constant) {
+        return make_constant(std::log(constant_value(arg_simp)));
+    }
+    if (arg_simp->kind() == Kind::Exponential) {
+        return arg_simp->operand(0);
+    }
+    return log(arg_simp);
+}
+
+// Expression store
+
+ExpressionStore& ExpressionStore::global() {
+    static ExpressionStore store;
+    return store;
+}
+
+std::size_t ExpressionStore::KeyHash::operator()(const Key& k) const {
+    std::size_t h = std::hash<int>()(static_cast<int>(k.kind));
+    auto mix = [&h](std::size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+    mix(std::hash<double>()(k.value));
+    mix(std::hash<std::string>()(k.name));
+    mix(std::hash<const void*>()(k.a));
+    mix(std::hash<const void*>()(k.b));
+    return h;
+}
+
+std::shared_ptr<Expression> ExpressionStore::intern(const Key& key,
+                                                    const std::function<std::shared_ptr<Expression>()>& create) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(key);
+    if (it != table_.end()) {
+        return it->second;
+    }
+    auto node = create();
+    table_.emplace(key, node);
+    return node;
+}
+
+std::shared_ptr<Expression> ExpressionStore::constant(double value) {
+    return intern(Key{Kind::Constant, value, {}, nullptr, nullptr},
+                  [value] { return std::make_shared<Constant>(value); });
+}
+
+std::shared_ptr<Expression> ExpressionStore::variable(const std::string& name) {
+    return intern(Key{Kind::Variable, 0.0, name, nullptr, nullptr},
+                  [&name] { return std::make_shared<Variable>(name); });
+}
+
+std::shared_ptr<Expression> ExpressionStore::node(Kind kind, std::shared_ptr<Expression> a,
+                                                  std::shared_ptr<Expression> b) {
+    // Operands are interned too when they came from the factories, so
+    // comparing their addresses compares their structure
+    const Key key{kind, 0.0, {}, a.get(), b.get()};
+    switch (kind) {
+        case Kind::Sum:
+            return intern(key, [&] { return std::make_shared<Sum>(a, b); });
+        case Kind::Product:
+            return intern(key, [&] { return std::make_shared<Product>(a, b); });
+        case Kind::Quotient:
+            return intern(key, [&] { return std::make_shared<Quotient>(a, b); });
+        case Kind::Power:
+            return intern(key, [&] { return std::make_shared<Power>(a, b); });
+        case Kind::Sine:
+            return intern(key, [&] { return std::make_shared<Sine>(a); });
+        case Kind::Cosine:
+            return intern(key, [&] { return std::make_shared<Cosine>(a); });
+        case Kind::Exponential:
+            return intern(key, [&] { return std::make_shared<Exponential>(a); });
+        case Kind::Logarithm:
+            return intern(key, [&] { return std::make_shared<Logarithm>(a); });
+        default:
+            throw std::invalid_argument("ExpressionStore::node: not an operator kind");
+    }
+}
+
+std::shared_ptr<Expression> ExpressionStore::find_derivative(const Expression* e, const std::string& var) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = derivatives_.find(MemoKey{e, var});
+    return it != derivatives_.end() ? it->second.result : nullptr;
+}
+
+void ExpressionStore::store_derivative(std::shared_ptr<const Expression> e, const std::string& var,
+                                       std::shared_ptr<Expression> d) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Expression* key = e.get();
+    derivatives_.emplace(MemoKey{key, var}, MemoEntry{std::move(e), std::move(d)});
+}
+
+std::shared_ptr<Expression> ExpressionStore::find_simplified(const Expression* e) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = simplified_.find(e);
+    return it != simplified_.end() ? it->second.result : nullptr;
+}
+
+void ExpressionStore::store_simplified(std::shared_ptr<const Expression> e, std::shared_ptr<Expression> s) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Expression* key = e.get();
+    simplified_.emplace(key, MemoEntry{std::move(e), std::move(s)});
+}
+
+std::size_t ExpressionStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.size();
+}
+
+void ExpressionStore::clear() {
+    // Release outside the lock: destroying nodes does not re-enter the
+    // store, but keeps the critical section short
+    std::unordered_map<Key, std::shared_ptr<Expression>, KeyHash> table;
+    std::unordered_map<MemoKey, MemoEntry, MemoKeyHash> derivatives;
+    std::unordered_map<const Expression*, MemoEntry> simplified;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        table.swap(table_);
+        derivatives.swap(derivatives_);
+        simplified.swap(simplified_);
+    }
 }
 
 // Funciones de conveniencia
 std::shared_ptr<Expression> make_constant(double value) {
-    return std::make_shared<Constant>(value);
+    return ExpressionStore::global().constant(value);
 }
 
 std::shared_ptr<Expression> make_variable(const std::string& name) {
-    return std::make_shared<Variable>(name);
+    return ExpressionStore::global().variable(name);
 }
 
 std::shared_ptr<Expression> operator+(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right) {
-    return std::make_shared<Sum>(left, right);
+    return ExpressionStore::global().node(Kind::Sum, left, right);
 }
 
 std::shared_ptr<Expression> operator*(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right) {
-    return std::make_shared<Product>(left, right);
+    return ExpressionStore::global().node(Kind::Product, left, right);
+}
+
+// f - g is stored as f + (-1) * g, so Sum and Product cover it
+std::shared_ptr<Expression> operator-(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right) {
+    return left + make_constant(-1.0) * right;
+}
+
+std::shared_ptr<Expression> operator-(std::shared_ptr<Expression> arg) {
+    return make_constant(-1.0) * arg;
+}
+
+std::shared_ptr<Expression> operator/(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right) {
+    return ExpressionStore::global().node(Kind::Quotient, left, right);
 }
 
 std::shared_ptr<Expression> sin(std::shared_ptr<Expression> arg) {
-    return std::make_shared<Sine>(arg);
+    return ExpressionStore::global().node(Kind::Sine, arg);
+}
+
+std::shared_ptr<Expression> cos(std::shared_ptr<Expression> arg) {
+    return ExpressionStore::global().node(Kind::Cosine, arg);
+}
+
+std::shared_ptr<Expression> exp(std::shared_ptr<Expression> arg) {
+    return ExpressionStore::global().node(Kind::Exponential, arg);
+}
+
+std::shared_ptr<Expression> log(std::shared_ptr<Expression> arg) {
+    return ExpressionStore::global().node(Kind::Logarithm, arg);
+}
+
+std::shared_ptr<Expression> pow(std::shared_ptr<Expression> base, std::shared_ptr<Expression> exponent) {
+    return ExpressionStore::global().node(Kind::Power, base, exponent);
+}
+
+std::shared_ptr<Expression> pow(std::shared_ptr<Expression> base, double exponent) {
+    return pow(base, make_constant(exponent));
 }
 
-} // namespace symbolic
\ No newline at end of file
+} // namespace symbolic
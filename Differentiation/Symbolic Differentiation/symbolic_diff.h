@@ -4,33 +4,61 @@
 #include <memory>
 #include <string>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 namespace symbolic {
 
-class Expression {
+enum class Kind { Constant, Variable, Sum, Product, Quotient, Power, Sine, Cosine, Exponential, Logarithm };
+
+// Expressions form a DAG. Nodes built through the factory functions below
+// (make_constant, make_variable, the arithmetic operators, sin, cos, exp,
+// log, pow) are
+// hash-consed in an ExpressionStore: structurally equal nodes are one
+// object, so equality is pointer equality and shared subtrees are stored
+// once. derivative() and simplify() are memoized per (node, variable), so
+// differentiating a DAG costs one step per distinct node.
+class Expression : public std::enable_shared_from_this<Expression> {
 public:
     virtual ~Expression() = default;
     virtual std::string to_string() const = 0;
-    virtual std::shared_ptr<Expression> derivative(const std::string& var) const = 0;
-    virtual std::shared_ptr<Expression> simplify() const = 0;
+
+    std::shared_ptr<Expression> derivative(const std::string& var) const;
+    std::shared_ptr<Expression> simplify() const;
+
+    virtual Kind kind() const = 0;
+    virtual std::size_t arity() const { return 0; }
+    virtual const std::shared_ptr<Expression>& operand(std::size_t i) const;
+
+protected:
+    virtual std::shared_ptr<Expression> compute_derivative(const std::string& var) const = 0;
+    virtual std::shared_ptr<Expression> compute_simplify() const = 0;
 };
 
 class Constant : public Expression {
     double value_;
 public:
     explicit Constant(double value) : value_(value) {}
+    double value() const { return value_; }
     std::string to_string() const override;
-    std::shared_ptr<Expression> derivative(const std::string& var) const override;
-    std::shared_ptr<Expression> simplify() const override;
+    Kind kind() const override { return Kind::Constant; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
 };
 
 class Variable : public Expression {
     std::string name_;
 public:
     explicit Variable(const std::string& name) : name_(name) {}
+    const std::string& name() const { return name_; }
     std::string to_string() const override;
-    std::shared_ptr<Expression> derivative(const std::string& var) const override;
-    std::shared_ptr<Expression> simplify() const override;
+    Kind kind() const override { return Kind::Variable; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
 };
 
 class Sum : public Expression {
@@ -39,8 +67,12 @@ public:
     Sum(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
         : left_(left), right_(right) {}
     std::string to_string() const override;
-    std::shared_ptr<Expression> derivative(const std::string& var) const override;
-    std::shared_ptr<Expression> simplify() const override;
+    Kind kind() const override { return Kind::Sum; }
+    std::size_t arity() const override { return 2; }
+    const std::shared_ptr<Expression>& operand(std::size_t i) const override { return i == 0 ? left_ : right_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
 };
 
 class Product : public Expression {
@@ -49,8 +81,41 @@ public:
     Product(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
         : left_(left), right_(right) {}
     std::string to_string() const override;
-    std::shared_ptr<Expression> derivative(const std::string& var) const override;
-    std::shared_ptr<Expression> simplify() const override;
+    Kind kind() const override { return Kind::Product; }
+    std::size_t arity() const override { return 2; }
+    const std::shared_ptr<Expression>& operand(std::size_t i) const override { return i == 0 ? left_ : right_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
+};
+
+class Quotient : public Expression {
+    std::shared_ptr<Expression> left_, right_;
+public:
+    Quotient(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
+        : left_(left), right_(right) {}
+    std::string to_string() const override;
+    Kind kind() const override { return Kind::Quotient; }
+    std::size_t arity() const override { return 2; }
+    const std::shared_ptr<Expression>& operand(std::size_t i) const override { return i == 0 ? left_ : right_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
+};
+
+// left raised to right
+class Power : public Expression {
+    std::shared_ptr<Expression> left_, right_;
+public:
+    Power(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
+        : left_(left), right_(right) {}
+    std::string to_string() const override;
+    Kind kind() const override { return Kind::Power; }
+    std::size_t arity() const override { return 2; }
+    const std::shared_ptr<Expression>& operand(std::size_t i) const override { return i == 0 ? left_ : right_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
 };
 
 class Sine : public Expression {
@@ -58,16 +123,133 @@ class Sine : public Expression {
 public:
     explicit Sine(std::shared_ptr<Expression> arg) : arg_(arg) {}
     std::string to_string() const override;
-    std::shared_ptr<Expression> derivative(const std::string& var) const override;
-    std::shared_ptr<Expression> simplify() const override;
+    Kind kind() const override { return Kind::Sine; }
+    std::size_t arity() const override { return 1; }
+    const std::shared_ptr<Expression>& operand(std::size_t) const override { return arg_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
+};
+
+class Cosine : public Expression {
+    std::shared_ptr<Expression> arg_;
+public:
+    explicit Cosine(std::shared_ptr<Expression> arg) : arg_(arg) {}
+    std::string to_string() const override;
+    Kind kind() const override { return Kind::Cosine; }
+    std::size_t arity() const override { return 1; }
+    const std::shared_ptr<Expression>& operand(std::size_t) const override { return arg_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
+};
+
+class Exponential : public Expression {
+    std::shared_ptr<Expression> arg_;
+public:
+    explicit Exponential(std::shared_ptr<Expression> arg) : arg_(arg) {}
+    std::string to_string() const override;
+    Kind kind() const override { return Kind::Exponential; }
+    std::size_t arity() const override { return 1; }
+    const std::shared_ptr<Expression>& operand(std::size_t) const override { return arg_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
+};
+
+class Logarithm : public Expression {
+    std::shared_ptr<Expression> arg_;
+public:
+    explicit Logarithm(std::shared_ptr<Expression> arg) : arg_(arg) {}
+    std::string to_string() const override;
+    Kind kind() const override { return Kind::Logarithm; }
+    std::size_t arity() const override { return 1; }
+    const std::shared_ptr<Expression>& operand(std::size_t) const override { return arg_; }
+protected:
+    std::shared_ptr<Expression> compute_derivative(const std::string& var) const override;
+    std::shared_ptr<Expression> compute_simplify() const override;
+};
+
+// Interning table and derivative / simplification memo. The store keeps
+// every node it has handed out alive until clear(); the factory functions
+// use ExpressionStore::global().
+class ExpressionStore {
+public:
+    static ExpressionStore& global();
+
+    std::shared_ptr<Expression> constant(double value);
+    std::shared_ptr<Expression> variable(const std::string& name);
+    // Sum, Product, Quotient, Power (two operands) or Sine, Cosine,
+    // Exponential, Logarithm (one)
+    std::shared_ptr<Expression> node(Kind kind, std::shared_ptr<Expression> a,
+                                     std::shared_ptr<Expression> b = nullptr);
+
+    // Memo entries keep their node alive, so a key is never reused by
+    // another node at the same address
+    std::shared_ptr<Expression> find_derivative(const Expression* e, const std::string& var) const;
+    void store_derivative(std::shared_ptr<const Expression> e, const std::string& var, std::shared_ptr<Expression> d);
+    std::shared_ptr<Expression> find_simplified(const Expression* e) const;
+    void store_simplified(std::shared_ptr<const Expression> e, std::shared_ptr<Expression> s);
+
+    // Interned nodes
+    std::size_t size() const;
+    // Forgets all interned nodes and memoized results; expressions still
+    // referenced elsewhere stay valid but are no longer shared with new ones
+    void clear();
+
+private:
+    struct Key {
+        Kind kind;
+        double value;
+        std::string name;
+        const Expression* a;
+        const Expression* b;
+        bool operator==(const Key& other) const {
+            return kind == other.kind && value == other.value && name == other.name
+                && a == other.a && b == other.b;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const;
+    };
+    struct MemoKey {
+        const Expression* node;
+        std::string var;
+        bool operator==(const MemoKey& other) const { return node == other.node && var == other.var; }
+    };
+    struct MemoKeyHash {
+        std::size_t operator()(const MemoKey& k) const {
+            return std::hash<const void*>()(k.node) ^ (std::hash<std::string>()(k.var) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    std::shared_ptr<Expression> intern(const Key& key, const std::function<std::shared_ptr<Expression>()>& create);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::shared_ptr<Expression>, KeyHash> table_;
+    struct MemoEntry {
+        std::shared_ptr<const Expression> node;
+        std::shared_ptr<Expression> result;
+    };
+
+    std::unordered_map<MemoKey, MemoEntry, MemoKeyHash> derivatives_;
+    std::unordered_map<const Expression*, MemoEntry> simplified_;
 };
 
 std::shared_ptr<Expression> make_constant(double value);
 std::shared_ptr<Expression> make_variable(const std::string& name);
 std::shared_ptr<Expression> operator+(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right);
 std::shared_ptr<Expression> operator*(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right);
+std::shared_ptr<Expression> operator-(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right);
+std::shared_ptr<Expression> operator-(std::shared_ptr<Expression> arg);
+std::shared_ptr<Expression> operator/(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right);
 std::shared_ptr<Expression> sin(std::shared_ptr<Expression> arg);
+std::shared_ptr<Expression> cos(std::shared_ptr<Expression> arg);
+std::shared_ptr<Expression> exp(std::shared_ptr<Expression> arg);
+std::shared_ptr<Expression> log(std::shared_ptr<Expression> arg);
+std::shared_ptr<Expression> pow(std::shared_ptr<Expression> base, std::shared_ptr<Expression> exponent);
+std::shared_ptr<Expression> pow(std::shared_ptr<Expression> base, double exponent);
 
-} 
+}
 
-#endif // SYMBOLIC_DIFF_H
\ No newline at end of file
+#endif // SYMBOLIC_DIFF_H
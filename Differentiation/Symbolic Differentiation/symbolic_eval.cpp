@@ -0,0 +1,231 @@
+#include "symbolic_eval.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace symbolic {
+
+namespace {
+
+// Node of the DAG in topological order, before register allocation
+struct Step {
+    CompiledExpression::Op op;
+    const Expression* a;
+    const Expression* b;
+};
+
+CompiledExpression::Op op_for(Kind kind) {
+    switch (kind) {
+        case Kind::Sum: return CompiledExpression::Op::Add;
+        case Kind::Product: return CompiledExpression::Op::Mul;
+        case Kind::Quotient: return CompiledExpression::Op::Div;
+        case Kind::Power: return CompiledExpression::Op::Pow;
+        case Kind::Sine: return CompiledExpression::Op::Sin;
+        case Kind::Cosine: return CompiledExpression::Op::Cos;
+        case Kind::Exponential: return CompiledExpression::Op::Exp;
+        case Kind::Logarithm: return CompiledExpression::Op::Log;
+        default: throw std::invalid_argument("CompiledExpression: unsupported expression kind");
+    }
+}
+
+}
+
+CompiledExpression::CompiledExpression(const std::shared_ptr<Expression>& output,
+                                       const std::vector<std::string>& variables)
+    : CompiledExpression(std::vector<std::shared_ptr<Expression>>{output}, variables) {}
+
+CompiledExpression::CompiledExpression(const std::vector<std::shared_ptr<Expression>>& outputs,
+                                       const std::vector<std::string>& variables)
+    : num_variables_(variables.size())
+{
+    std::unordered_map<std::string, std::uint32_t> variable_index;
+    for (std::size_t v = 0; v < variables.size(); ++v) {
+        variable_index.emplace(variables[v], static_cast<std::uint32_t>(v));
+    }
+
+    // Leaves go to fixed registers; interior nodes get a step number
+    std::unordered_map<const Expression*, std::uint32_t> leaf_register;
+    std::unordered_map<double, std::uint32_t> constant_register;
+    std::unordered_map<const Expression*, std::uint32_t> step_of;
+    std::vector<Step> steps;
+
+    auto visit_leaf = [&](const Expression* e) {
+        if (e->kind() == Kind::Variable) {
+            const auto it = variable_index.find(static_cast<const Variable*>(e)->name());
+            if (it == variable_index.end()) {
+                throw std::invalid_argument("CompiledExpression: unknown variable " + e->to_string());
+            }
+            leaf_register.emplace(e, it->second);
+        } else {
+            const double value = static_cast<const Constant*>(e)->value();
+            auto [it, inserted] = constant_register.emplace(value, 0);
+            if (inserted) {
+                it->second = static_cast<std::uint32_t>(num_variables_ + constants_.size());
+                constants_.push_back(value);
+            }
+            leaf_register.emplace(e, it->second);
+        }
+    };
+
+    // Iterative post-order DFS over the distinct nodes
+    for (const auto& root : outputs) {
+        std::vector<std::pair<const Expression*, bool>> stack{{root.get(), false}};
+        while (!stack.empty()) {
+            auto [e, expanded] = stack.back();
+            stack.pop_back();
+            if (leaf_register.count(e) || step_of.count(e)) continue;
+            if (e->arity() == 0) {
+                visit_leaf(e);
+                continue;
+            }
+            if (!expanded) {
+                stack.push_back({e, true});
+                for (std::size_t i = e->arity(); i-- > 0;) stack.push_back({e->operand(i).get(), false});
+            } else {
+                const Expression* b = e->arity() > 1 ? e->operand(1).get() : e->operand(0).get();
+                step_of.emplace(e, static_cast<std::uint32_t>(steps.size()));
+                steps.push_back(Step{op_for(e->kind()), e->operand(0).get(), b});
+            }
+        }
+    }
+
+    // Last step reading each step's value; outputs stay live to the end
+    const std::uint32_t end = static_cast<std::uint32_t>(steps.size());
+    std::vector<std::uint32_t> last_use(steps.size(), 0);
+    for (std::uint32_t s = 0; s < steps.size(); ++s) {
+        for (const Expression* operand : {steps[s].a, steps[s].b}) {
+            const auto it = step_of.find(operand);
+            if (it != step_of.end()) last_use[it->second] = s;
+        }
+    }
+    for (const auto& root : outputs) {
+        const auto it = step_of.find(root.get());
+        if (it != step_of.end()) last_use[it->second] = end;
+    }
+
+    // Linear scan: a temporary is released after the last step reading it,
+    // so the destination of that step may reuse it
+    const std::uint32_t first_temporary = static_cast<std::uint32_t>(num_variables_ + constants_.size());
+    std::uint32_t next_temporary = first_temporary;
+    std::vector<std::uint32_t> free_registers;
+    std::vector<std::uint32_t> register_of(steps.size());
+
+    auto register_for = [&](const Expression* e) {
+        const auto it = step_of.find(e);
+        return it != step_of.end() ? register_of[it->second] : leaf_register.at(e);
+    };
+
+    code_.reserve(steps.size());
+    for (std::uint32_t s = 0; s < steps.size(); ++s) {
+        const std::uint32_t a = register_for(steps[s].a);
+        const std::uint32_t b = register_for(steps[s].b);
+
+        for (const Expression* operand : {steps[s].a, steps[s].b}) {
+            const auto it = step_of.find(operand);
+            if (it != step_of.end() && last_use[it->second] == s &&
+                std::find(free_registers.begin(), free_registers.end(), register_of[it->second]) == free_registers.end()) {
+                free_registers.push_back(register_of[it->second]);
+            }
+        }
+
+        std::uint32_t dst;
+        if (!free_registers.empty()) {
+            dst = free_registers.back();
+            free_registers.pop_back();
+        } else {
+            dst = next_temporary++;
+        }
+        register_of[s] = dst;
+        code_.push_back(Instruction{steps[s].op, dst, a, b});
+    }
+    num_registers_ = next_temporary;
+
+    for (const auto& root : outputs) {
+        outputs_.push_back(register_for(root.get()));
+    }
+}
+
+double CompiledExpression::evaluate(const double* inputs) const {
+    double result;
+    if (outputs_.size() == 1) {
+        evaluate(inputs, &result);
+    } else {
+        std::vector<double> all(outputs_.size());
+        evaluate(inputs, all.data());
+        result = all[0];
+    }
+    return result;
+}
+
+void CompiledExpression::evaluate(const double* inputs, double* outputs) const {
+    thread_local std::vector<double> registers;
+    registers.resize(num_registers_);
+    double* r = registers.data();
+    std::copy(inputs, inputs + num_variables_, r);
+    std::copy(constants_.begin(), constants_.end(), r + num_variables_);
+
+    for (const Instruction& in : code_) {
+        switch (in.op) {
+            case Op::Add: r[in.dst] = r[in.a] + r[in.b]; break;
+            case Op::Mul: r[in.dst] = r[in.a] * r[in.b]; break;
+            case Op::Div: r[in.dst] = r[in.a] / r[in.b]; break;
+            case Op::Pow: r[in.dst] = std::pow(r[in.a], r[in.b]); break;
+            case Op::Sin: r[in.dst] = std::sin(r[in.a]); break;
+            case Op::Cos: r[in.dst] = std::cos(r[in.a]); break;
+            case Op::Exp: r[in.dst] = std::exp(r[in.a]); break;
+            case Op::Log: r[in.dst] = std::log(r[in.a]); break;
+        }
+    }
+    for (std::size_t o = 0; o < outputs_.size(); ++o) {
+        outputs[o] = r[outputs_[o]];
+    }
+}
+
+void CompiledExpression::evaluate_batch(const double* inputs, std::size_t count, double* outputs) const {
+    constexpr std::size_t B = block_size;
+
+    // Constant and temporary registers are blocks of storage (constants
+    // filled once per call); variable registers point into the inputs.
+    // Destinations are always temporaries.
+    thread_local std::vector<double> storage;
+    storage.resize((num_registers_ - num_variables_) * B);
+    auto block = [&](std::size_t r) { return storage.data() + (r - num_variables_) * B; };
+    for (std::size_t c = 0; c < constants_.size(); ++c) {
+        std::fill_n(block(num_variables_ + c), B, constants_[c]);
+    }
+    std::vector<const double*> reg(num_registers_);
+    for (std::size_t r = num_variables_; r < num_registers_; ++r) {
+        reg[r] = block(r);
+    }
+
+    for (std::size_t start = 0; start < count; start += B) {
+        const std::size_t n = std::min(B, count - start);
+        for (std::size_t v = 0; v < num_variables_; ++v) {
+            reg[v] = inputs + v * count + start;
+        }
+
+        for (const Instruction& in : code_) {
+            double* d = block(in.dst);
+            const double* a = reg[in.a];
+            const double* b = reg[in.b];
+            switch (in.op) {
+                case Op::Add: for (std::size_t i = 0; i < n; ++i) d[i] = a[i] + b[i]; break;
+                case Op::Mul: for (std::size_t i = 0; i < n; ++i) d[i] = a[i] * b[i]; break;
+                case Op::Div: for (std::size_t i = 0; i < n; ++i) d[i] = a[i] / b[i]; break;
+                case Op::Pow: for (std::size_t i = 0; i < n; ++i) d[i] = std::pow(a[i], b[i]); break;
+                case Op::Sin: for (std::size_t i = 0; i < n; ++i) d[i] = std::sin(a[i]); break;
+                case Op::Cos: for (std::size_t i = 0; i < n; ++i) d[i] = std::cos(a[i]); break;
+                case Op::Exp: for (std::size_t i = 0; i < n; ++i) d[i] = std::exp(a[i]); break;
+                case Op::Log: for (std::size_t i = 0; i < n; ++i) d[i] = std::log(a[i]); break;
+            }
+        }
+
+        for (std::size_t o = 0; o < outputs_.size(); ++o) {
+            std::copy_n(reg[outputs_[o]], n, outputs + o * count + start);
+        }
+    }
+}
+
+}
@@ -0,0 +1,68 @@
+#ifndef SYMBOLIC_EVAL_H
+#define SYMBOLIC_EVAL_H
+
+#include "symbolic_diff.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace symbolic {
+
+// An expression DAG (or several sharing nodes, e.g. a function and its
+// derivatives) compiled to register bytecode.
+//
+// Compilation orders the distinct nodes topologically, so a shared
+// subexpression becomes one instruction, and assigns registers with a
+// linear scan over the last use of each value. Registers [0, variables)
+// hold the inputs and the next ones the constants, so neither needs an
+// instruction.
+//
+// evaluate() runs the program on one point. evaluate_batch() runs it on
+// many: each register is a block of points and each instruction a loop
+// over the block, which the compiler vectorizes, so the interpretation
+// overhead is paid once per block instead of once per point.
+class CompiledExpression {
+public:
+    enum class Op : std::uint8_t { Add, Mul, Div, Pow, Sin, Cos, Exp, Log };
+
+    struct Instruction {
+        Op op;
+        std::uint32_t dst, a, b;
+    };
+
+    // Points per block in evaluate_batch
+    static constexpr std::size_t block_size = 256;
+
+    CompiledExpression(const std::shared_ptr<Expression>& output, const std::vector<std::string>& variables);
+    CompiledExpression(const std::vector<std::shared_ptr<Expression>>& outputs,
+                       const std::vector<std::string>& variables);
+
+    // inputs[v] is variable v; returns the first output
+    double evaluate(const double* inputs) const;
+    double evaluate(const std::vector<double>& inputs) const { return evaluate(inputs.data()); }
+    // outputs[o] receives output o
+    void evaluate(const double* inputs, double* outputs) const;
+
+    // count points; inputs[v * count + p] is variable v at point p and
+    // outputs[o * count + p] receives output o at point p
+    void evaluate_batch(const double* inputs, std::size_t count, double* outputs) const;
+
+    std::size_t num_variables() const { return num_variables_; }
+    std::size_t num_outputs() const { return outputs_.size(); }
+    std::size_t num_registers() const { return num_registers_; }
+    const std::vector<Instruction>& instructions() const { return code_; }
+
+private:
+    std::size_t num_variables_ = 0;
+    std::size_t num_registers_ = 0;
+    std::vector<double> constants_;            // register num_variables_ + i
+    std::vector<Instruction> code_;
+    std::vector<std::uint32_t> outputs_;       // register of each output
+};
+
+}
+
+#endif // SYMBOLIC_EVAL_H
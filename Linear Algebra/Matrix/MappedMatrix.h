@@ -0,0 +1,354 @@
+#pragma once
+
+#include "Matrix.h"
+#include "MatrixKernels.h"
+#include "../../Appendix/Mapped File/mapped_file.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// On-disk layout of a MappedMatrix file:
+//
+//   [ header (64 bytes) | zero padding up to data_offset | tiles ... ]
+//
+// The matrix is cut into tile x tile blocks stored one after another in
+// row-major tile order; each block is itself row-major. Edge blocks are
+// stored at full size and zero-padded, so every block starts at
+// data_offset + (ti * tile_cols + tj) * tile * tile * element_size.
+struct MappedMatrixHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::int64_t rows;
+    std::int64_t columns;
+    std::int64_t tile;
+    std::int64_t data_offset;
+    char reserved[16];
+};
+static_assert(sizeof(MappedMatrixHeader) == 64, "MappedMatrixHeader must stay 64 bytes");
+
+// Matrix whose storage is a memory-mapped file instead of a heap buffer,
+// for operands larger than RAM. Element access works as for Matrix<T>,
+// but the tiled algorithms below are the intended way to touch it: they
+// work one block at a time and tell the kernel which blocks come next.
+template <class T>
+class MappedMatrix {
+    public:
+    static constexpr char file_magic[8] = {'N', 'C', 'M', 'T', 'I', 'L', 'E', 'D'};
+    static constexpr std::uint32_t file_version = 1;
+    // Data starts on a page boundary so tiles of page-multiple size stay page aligned
+    static constexpr std::int64_t data_alignment = 4096;
+
+    // Creates a zero-filled matrix backed by a new file
+    static MappedMatrix<T> create(const std::string& path, int rows, int columns, int tile = 256) {
+        if (rows <= 0 || columns <= 0 || tile <= 0) {
+            throw std::invalid_argument("MappedMatrix dimensions and tile size must be positive");
+        }
+
+        MappedMatrixHeader header{};
+        std::memcpy(header.magic, file_magic, sizeof(file_magic));
+        header.version = file_version;
+        header.element_size = sizeof(T);
+        header.rows = rows;
+        header.columns = columns;
+        header.tile = tile;
+        header.data_offset = data_alignment;
+
+        const std::int64_t tiles = static_cast<std::int64_t>((rows + tile - 1) / tile) * ((columns + tile - 1) / tile);
+        const std::int64_t bytes = data_alignment + tiles * tile * tile * static_cast<std::int64_t>(sizeof(T));
+
+        MappedMatrix<T> result;
+        result.file = appendix::MappedFile::create(path, static_cast<std::size_t>(bytes));
+        std::memcpy(result.file.data(), &header, sizeof(header));
+        result.load_header();
+        return result;
+    }
+
+    // Maps an existing file written by create()
+    static MappedMatrix<T> open(const std::string& path, bool writable = false) {
+        MappedMatrix<T> result;
+        result.file = appendix::MappedFile::open(path, writable ? appendix::MappedFile::Mode::ReadWrite
+                                                               : appendix::MappedFile::Mode::ReadOnly);
+        result.load_header();
+        return result;
+    }
+
+    // Writes an in-memory matrix out in tiled layout
+    static MappedMatrix<T> from_matrix(const std::string& path, const Matrix<T>& source, int tile = 256) {
+        MappedMatrix<T> result = create(path, source.get_num_rows(), source.get_num_cols(), tile);
+        for (int ti = 0; ti < result.tile_rows; ++ti) {
+            for (int tj = 0; tj < result.tile_cols; ++tj) {
+                T* block = result.tile_data(ti, tj);
+                for (int i = 0; i < result.tile_height(ti); ++i) {
+                    for (int j = 0; j < result.tile_width(tj); ++j) {
+                        block[i * tile + j] = source(ti * tile + i, tj * tile + j);
+                    }
+                }
+                result.evict_tile(ti, tj);
+            }
+        }
+        return result;
+    }
+
+    // Reads the whole matrix back into memory
+    Matrix<T> to_matrix() const {
+        Matrix<T> result(rows, columns);
+        for (int ti = 0; ti < tile_rows; ++ti) {
+            for (int tj = 0; tj < tile_cols; ++tj) {
+                const T* block = tile_data(ti, tj);
+                for (int i = 0; i < tile_height(ti); ++i) {
+                    for (int j = 0; j < tile_width(tj); ++j) {
+                        result(ti * tile + i, tj * tile + j) = block[i * tile + j];
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    int get_num_rows() const { return rows; }
+    int get_num_cols() const { return columns; }
+    int tile_size() const { return tile; }
+    int num_tile_rows() const { return tile_rows; }
+    int num_tile_cols() const { return tile_cols; }
+
+    // Rows and columns of tile (ti, tj) that lie inside the matrix
+    int tile_height(int ti) const { return std::min(tile, rows - ti * tile); }
+    int tile_width(int tj) const { return std::min(tile, columns - tj * tile); }
+
+    T* tile_data(int ti, int tj) {
+        return reinterpret_cast<T*>(file.data() + tile_offset(ti, tj));
+    }
+
+    const T* tile_data(int ti, int tj) const {
+        return reinterpret_cast<const T*>(file.data() + tile_offset(ti, tj));
+    }
+
+    T& operator()(int row, int col) {
+        return tile_data(row / tile, col / tile)[(row % tile) * tile + col % tile];
+    }
+
+    const T& operator()(int row, int col) const {
+        return tile_data(row / tile, col / tile)[(row % tile) * tile + col % tile];
+    }
+
+    // Asks the kernel to start reading tile (ti, tj); out-of-range indices are ignored
+    void prefetch_tile(int ti, int tj) const {
+        if (ti >= 0 && ti < tile_rows && tj >= 0 && tj < tile_cols) {
+            file.will_need(tile_offset(ti, tj), tile_bytes());
+        }
+    }
+
+    // Drops tile (ti, tj) from this process's working set
+    void evict_tile(int ti, int tj) const {
+        file.dont_need(tile_offset(ti, tj), tile_bytes());
+    }
+
+    void flush() { file.flush(); }
+
+    private:
+    void load_header() {
+        if (file.size() < sizeof(MappedMatrixHeader)) {
+            throw std::runtime_error("MappedMatrix file is too small for its header");
+        }
+
+        MappedMatrixHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) {
+            throw std::runtime_error("Not a MappedMatrix file");
+        }
+        if (header.version != file_version) {
+            throw std::runtime_error("Unsupported MappedMatrix file version");
+        }
+        if (header.element_size != sizeof(T)) {
+            throw std::runtime_error("MappedMatrix element size does not match the requested type");
+        }
+
+        // Same limits as create(); the sizes below are then checked by
+        // division against the file size so that no product can overflow
+        constexpr std::int64_t int_max = std::numeric_limits<int>::max();
+        if (header.rows <= 0 || header.columns <= 0 || header.tile <= 0
+            || header.rows > int_max || header.columns > int_max || header.tile > int_max) {
+            throw std::runtime_error("MappedMatrix dimensions and tile size in the header are out of range");
+        }
+        if (header.data_offset < static_cast<std::int64_t>(sizeof(MappedMatrixHeader))
+            || static_cast<std::uint64_t>(header.data_offset) > file.size()) {
+            throw std::runtime_error("MappedMatrix data offset in the header is out of range");
+        }
+
+        rows = static_cast<int>(header.rows);
+        columns = static_cast<int>(header.columns);
+        tile = static_cast<int>(header.tile);
+        data_offset = static_cast<std::size_t>(header.data_offset);
+        tile_rows = static_cast<int>((header.rows + header.tile - 1) / header.tile);
+        tile_cols = static_cast<int>((header.columns + header.tile - 1) / header.tile);
+
+        const std::size_t available = file.size() - data_offset;
+        const std::size_t tiles = static_cast<std::size_t>(tile_rows) * tile_cols;
+        if (static_cast<std::size_t>(tile) > available / tile / sizeof(T)
+            || tiles > available / tile_bytes()) {
+            throw std::runtime_error("MappedMatrix file is truncated");
+        }
+    }
+
+    std::size_t tile_bytes() const {
+        return static_cast<std::size_t>(tile) * tile * sizeof(T);
+    }
+
+    std::size_t tile_offset(int ti, int tj) const {
+        return data_offset + (static_cast<std::size_t>(ti) * tile_cols + tj) * tile_bytes();
+    }
+
+    appendix::MappedFile file;
+    int rows = 0, columns = 0, tile = 0;
+    int tile_rows = 0, tile_cols = 0;
+    std::size_t data_offset = 0;
+};
+
+// C = A * B, one tile product at a time. A and B must share the tile size
+// of C. While tile (i, k) x (k, j) is being multiplied the next pair is
+// already being paged in; finished C tiles and A row panels are evicted.
+template <class T>
+void tiled_multiply(const MappedMatrix<T>& A, const MappedMatrix<T>& B, MappedMatrix<T>& C) {
+    if (A.get_num_cols() != B.get_num_rows()
+        || C.get_num_rows() != A.get_num_rows() || C.get_num_cols() != B.get_num_cols()) {
+        throw std::invalid_argument("Matrices must have appropriate dimensions for multiplication");
+    }
+    if (A.tile_size() != C.tile_size() || B.tile_size() != C.tile_size()) {
+        throw std::invalid_argument("Tiled multiplication requires a common tile size");
+    }
+
+    const int nb = C.tile_size();
+    const int tk = A.num_tile_cols();
+
+    for (int ti = 0; ti < C.num_tile_rows(); ++ti) {
+        for (int tj = 0; tj < C.num_tile_cols(); ++tj) {
+            T* c = C.tile_data(ti, tj);
+            for (int p = 0; p < tk; ++p) {
+                if (p + 1 < tk) {
+                    A.prefetch_tile(ti, p + 1);
+                    B.prefetch_tile(p + 1, tj);
+                } else {
+                    A.prefetch_tile(ti, 0);
+                    B.prefetch_tile(0, tj + 1);
+                }
+                // Padding is zero, so full tiles can be multiplied as-is
+                matrix_kernels::gemm(nb, nb, nb, A.tile_data(ti, p), nb, B.tile_data(p, tj), nb,
+                                     c, nb, p > 0);
+            }
+            C.evict_tile(ti, tj);
+        }
+        for (int p = 0; p < tk; ++p) {
+            A.evict_tile(ti, p);
+        }
+    }
+}
+
+// At = A^T. Tile (i, j) of A becomes tile (j, i) of At.
+template <class T>
+void tiled_transpose(const MappedMatrix<T>& A, MappedMatrix<T>& At) {
+    if (At.get_num_rows() != A.get_num_cols() || At.get_num_cols() != A.get_num_rows()) {
+        throw std::invalid_argument("Transpose target has the wrong dimensions");
+    }
+    if (A.tile_size() != At.tile_size()) {
+        throw std::invalid_argument("Tiled transpose requires a common tile size");
+    }
+
+    const int nb = A.tile_size();
+    for (int ti = 0; ti < A.num_tile_rows(); ++ti) {
+        for (int tj = 0; tj < A.num_tile_cols(); ++tj) {
+            A.prefetch_tile(ti, tj + 1);
+            const T* src = A.tile_data(ti, tj);
+            T* dst = At.tile_data(tj, ti);
+            for (int i = 0; i < nb; ++i) {
+                for (int j = 0; j < nb; ++j) {
+                    dst[j * nb + i] = src[i * nb + j];
+                }
+            }
+            A.evict_tile(ti, tj);
+            At.evict_tile(tj, ti);
+        }
+    }
+}
+
+// In-place tiled Cholesky factorization A = L L^T (right-looking).
+// On return the lower triangle of A holds L and the strict upper triangle
+// is zero. Throws if A is not symmetric positive definite.
+template <class T>
+void tiled_cholesky(MappedMatrix<T>& A) {
+    if (A.get_num_rows() != A.get_num_cols()) {
+        throw std::invalid_argument("Cholesky Decomposition requires a square matrix");
+    }
+
+    const int nb = A.tile_size();
+    const int nt = A.num_tile_rows();
+
+    for (int k = 0; k < nt; ++k) {
+        // Factor the diagonal tile
+        T* akk = A.tile_data(k, k);
+        const int m = A.tile_height(k);
+        for (int j = 0; j < m; ++j) {
+            T d = akk[j * nb + j];
+            for (int p = 0; p < j; ++p) {
+                d -= akk[j * nb + p] * akk[j * nb + p];
+            }
+            if (!(d > T(0))) {
+                throw std::runtime_error("Matrix is not positive definite");
+            }
+            d = std::sqrt(d);
+            akk[j * nb + j] = d;
+            for (int i = j + 1; i < m; ++i) {
+                T s = akk[i * nb + j];
+                for (int p = 0; p < j; ++p) {
+                    s -= akk[i * nb + p] * akk[j * nb + p];
+                }
+                akk[i * nb + j] = s / d;
+            }
+            for (int i = 0; i < j; ++i) {
+                akk[i * nb + j] = T(0);
+            }
+        }
+
+        // Panel below the diagonal: A_ik <- A_ik L_kk^{-T}
+        for (int i = k + 1; i < nt; ++i) {
+            A.prefetch_tile(i + 1, k);
+            T* aik = A.tile_data(i, k);
+            for (int r = 0; r < A.tile_height(i); ++r) {
+                T* row = aik + r * nb;
+                for (int j = 0; j < m; ++j) {
+                    T s = row[j];
+                    for (int p = 0; p < j; ++p) {
+                        s -= row[p] * akk[j * nb + p];
+                    }
+                    row[j] = s / akk[j * nb + j];
+                }
+            }
+        }
+
+        // Trailing update of the lower triangle: A_ij -= A_ik A_jk^T
+        for (int i = k + 1; i < nt; ++i) {
+            for (int j = k + 1; j <= i; ++j) {
+                A.prefetch_tile(i, j + 1 <= i ? j + 1 : k + 1);
+                matrix_kernels::gemm_abt(nb, nb, nb, T(-1),
+                                         A.tile_data(i, k), nb, A.tile_data(j, k), nb,
+                                         A.tile_data(i, j), nb);
+            }
+        }
+
+        for (int i = k; i < nt; ++i) {
+            A.evict_tile(i, k);
+        }
+    }
+
+    // The strict upper triangle of tiles is not part of L
+    for (int i = 0; i < nt; ++i) {
+        for (int j = i + 1; j < A.num_tile_cols(); ++j) {
+            T* block = A.tile_data(i, j);
+            std::fill(block, block + static_cast<std::size_t>(nb) * nb, T(0));
+        }
+    }
+}
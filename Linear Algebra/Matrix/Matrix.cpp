@@ -1,23 +1,31 @@
 #include "Matrix.h"
+#include "MatrixKernels.h"
+#include "../../Appendix/Instrumentation/instrumentation.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 // Default constructor
 // New matrix with 0s
-template <class T>
-Matrix<T>::Matrix() {
+template <class T, class Alloc>
+Matrix<T, Alloc>::Matrix() {
     rows = 1;
     columns = 1;
     n_elements = 1;
-    matrix_data = new T[n_elements];
+    matrix_data = allocate_elements(n_elements);
     matrix_data[0] = 0.0;
 }
 
 // Constructor with specified rows and columns
-template <class T>
-Matrix<T>::Matrix(int rows, int columns) {
+template <class T, class Alloc>
+Matrix<T, Alloc>::Matrix(int rows, int columns) {
     this -> rows = rows;
     this -> columns = columns;
     n_elements = rows * columns;
-    matrix_data = new T[n_elements];
+    matrix_data = allocate_elements(n_elements);
 
     for(int i = 0; i < n_elements; i++){
         matrix_data[i] = 0.0;
@@ -25,12 +33,12 @@ Matrix<T>::Matrix(int rows, int columns) {
 }
 
 // Constructor with rows, columns, and data specified
-template <class T>
-Matrix<T>::Matrix(int rows, int columns, const T* input_data) {
+template <class T, class Alloc>
+Matrix<T, Alloc>::Matrix(int rows, int columns, const T* input_data) {
     this -> rows = rows;
     this -> columns = columns;
     n_elements = rows * columns;
-    matrix_data = new T[n_elements];
+    matrix_data = allocate_elements(n_elements);
 
     for(int i = 0; i < n_elements; i++){
         matrix_data[i] = input_data[i];
@@ -38,39 +46,108 @@ Matrix<T>::Matrix(int rows, int columns, const T* input_data) {
 }
 
 // Copy constructor
-template <class T>
-Matrix<T>::Matrix(const Matrix<T>& input_Matrix) {
+template <class T, class Alloc>
+Matrix<T, Alloc>::Matrix(const Matrix<T, Alloc>& input_Matrix) {
     rows = input_Matrix.rows;
     columns = input_Matrix.columns;
     n_elements = input_Matrix.n_elements;
-    matrix_data = new T[n_elements];
+    matrix_data = allocate_elements(n_elements);
 
     for(int i = 0; i < n_elements; i++){
         matrix_data[i] = input_Matrix.matrix_data[i];
     }
 }
 
+// Move constructor
+template <class T, class Alloc>
+Matrix<T, Alloc>::Matrix(Matrix<T, Alloc>&& input_Matrix) noexcept {
+    rows = input_Matrix.rows;
+    columns = input_Matrix.columns;
+    n_elements = input_Matrix.n_elements;
+    matrix_data = input_Matrix.matrix_data;
+
+    input_Matrix.rows = 0;
+    input_Matrix.columns = 0;
+    input_Matrix.n_elements = 0;
+    input_Matrix.matrix_data = nullptr;
+}
+
 // Destructor
-template <class T>
-Matrix<T>::~Matrix() {
-    if(matrix_data != nullptr){
-        delete[] matrix_data;
+template <class T, class Alloc>
+Matrix<T, Alloc>::~Matrix() {
+    deallocate_elements();
+}
+
+// Copy assignment
+// The buffer is only reallocated when the element count changes
+template <class T, class Alloc>
+Matrix<T, Alloc>& Matrix<T, Alloc>::operator=(const Matrix<T, Alloc>& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    if (n_elements != rhs.n_elements) {
+        deallocate_elements();
+        matrix_data = allocate_elements(rhs.n_elements);
+    }
+    rows = rhs.rows;
+    columns = rhs.columns;
+    n_elements = rhs.n_elements;
+
+    for (int i = 0; i < n_elements; i++) {
+        matrix_data[i] = rhs.matrix_data[i];
     }
+    return *this;
 }
 
-template <class T>
-int Matrix<T>::sub_to_index(int row, int col) const {
+// Move assignment
+template <class T, class Alloc>
+Matrix<T, Alloc>& Matrix<T, Alloc>::operator=(Matrix<T, Alloc>&& rhs) noexcept {
+    if (this != &rhs) {
+        swap(rhs);
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+void Matrix<T, Alloc>::swap(Matrix<T, Alloc>& other) noexcept {
+    std::swap(rows, other.rows);
+    std::swap(columns, other.columns);
+    std::swap(n_elements, other.n_elements);
+    std::swap(matrix_data, other.matrix_data);
+    std::swap(allocator, other.allocator);
+}
+
+template <class T, class Alloc>
+int Matrix<T, Alloc>::sub_to_index(int row, int col) const {
     return row * columns + col; 
 }
 
+// Element storage goes through the allocator policy
+template <class T, class Alloc>
+T* Matrix<T, Alloc>::allocate_elements(int count) {
+    T* p = std::allocator_traits<Alloc>::allocate(allocator, static_cast<std::size_t>(count));
+    std::uninitialized_default_construct_n(p, count);
+    return p;
+}
+
+template <class T, class Alloc>
+void Matrix<T, Alloc>::deallocate_elements() {
+    if (matrix_data != nullptr) {
+        std::destroy_n(matrix_data, n_elements);
+        std::allocator_traits<Alloc>::deallocate(allocator, matrix_data, static_cast<std::size_t>(n_elements));
+        matrix_data = nullptr;
+    }
+}
+
 // Resize the matrix
-template <class T>
-bool Matrix<T>::resize(int nRows, int nColumns) {
+template <class T, class Alloc>
+bool Matrix<T, Alloc>::resize(int nRows, int nColumns) {
+    deallocate_elements();
     rows = nRows;
     columns = nColumns;
     n_elements = (rows * columns);
-    delete[] matrix_data;
-    matrix_data = new T[n_elements];
+    matrix_data = allocate_elements(n_elements);
     if(matrix_data != nullptr){
         for(int i = 0; i < n_elements; i++){
             matrix_data[i] = 0.0;
@@ -81,8 +158,8 @@ bool Matrix<T>::resize(int nRows, int nColumns) {
     }
 }
 
-template <class T>
-T Matrix<T>::get_element(int row, int column) {
+template <class T, class Alloc>
+T Matrix<T, Alloc>::get_element(int row, int column) const {
     if (row >= rows || column >= columns || row < 0 || column < 0) {
         throw std::out_of_range("Index out of range");
     }
@@ -90,8 +167,8 @@ T Matrix<T>::get_element(int row, int column) {
 }
 
 
-template <class T>
-bool Matrix<T>::set_element(int row, int column, T element_value) {
+template <class T, class Alloc>
+bool Matrix<T, Alloc>::set_element(int row, int column, T element_value) {
     if (row >= rows || column >= columns || row < 0 || column < 0) {
         return false;
     }
@@ -100,18 +177,18 @@ bool Matrix<T>::set_element(int row, int column, T element_value) {
 }
 
 
-template <class T>
-int Matrix<T>::get_num_rows() {
+template <class T, class Alloc>
+int Matrix<T, Alloc>::get_num_rows() const {
     return rows;
 }
 
-template <class T>
-int Matrix<T>::get_num_cols() {
+template <class T, class Alloc>
+int Matrix<T, Alloc>::get_num_cols() const {
     return columns;
 }
 
-template <class T>
-bool Matrix<T>::operator==(const Matrix<T>& rhs) {
+template <class T, class Alloc>
+bool Matrix<T, Alloc>::operator==(const Matrix<T, Alloc>& rhs) {
     if (rows != rhs.rows || columns != rhs.columns) {
         return false;
     }
@@ -125,14 +202,30 @@ bool Matrix<T>::operator==(const Matrix<T>& rhs) {
     return true;
 }
 
+namespace {
+
+// Real FLOPs in one multiply-add of T
+template <class T>
+constexpr std::uint64_t multiply_add_flops() {
+    return matrix_kernels::is_complex_v<T> ? 8 : 2;
+}
+
+template <class T>
+std::uint64_t bytes_of(std::uint64_t elements) {
+    return elements * sizeof(T);
+}
+
+}
+
 // Matrix + Matrix
-template <class U>
-Matrix<U> operator+(const Matrix<U>& lhs, const Matrix<U>& rhs) {
+template <class U, class A>
+Matrix<U, A> operator+(const Matrix<U, A>& lhs, const Matrix<U, A>& rhs) {
     if (lhs.rows != rhs.rows || lhs.columns != rhs.columns) {
         throw std::invalid_argument("Matrices must have the same dimensions for addition");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.add", lhs.n_elements, bytes_of<U>(3ull * lhs.n_elements));
 
-    Matrix<U> result(lhs.rows, lhs.columns);
+    Matrix<U, A> result(lhs.rows, lhs.columns);
     for (int i = 0; i < lhs.n_elements; ++i) {
         result.matrix_data[i] = lhs.matrix_data[i] + rhs.matrix_data[i];
     }
@@ -141,9 +234,9 @@ Matrix<U> operator+(const Matrix<U>& lhs, const Matrix<U>& rhs) {
 }
 
 // Scalar + Matrix
-template <class U>
-Matrix<U> operator+(const U& lhs, const Matrix<U>& rhs) {
-    Matrix<U> result(rhs.rows, rhs.columns);
+template <class U, class A>
+Matrix<U, A> operator+(const U& lhs, const Matrix<U, A>& rhs) {
+    Matrix<U, A> result(rhs.rows, rhs.columns);
     for (int i = 0; i < rhs.n_elements; ++i) {
         result.matrix_data[i] = lhs + rhs.matrix_data[i];
     }
@@ -152,19 +245,20 @@ Matrix<U> operator+(const U& lhs, const Matrix<U>& rhs) {
 }
 
 // Matrix + Scalar
-template <class U>
-Matrix<U> operator+(const Matrix<U>& lhs, const U& rhs) {
+template <class U, class A>
+Matrix<U, A> operator+(const Matrix<U, A>& lhs, const U& rhs) {
     return rhs + lhs;  // Reusing Scalar + Matrix implementation
 }
 
 // Matrix - Matrix
-template <class U>
-Matrix<U> operator-(const Matrix<U>& lhs, const Matrix<U>& rhs) {
+template <class U, class A>
+Matrix<U, A> operator-(const Matrix<U, A>& lhs, const Matrix<U, A>& rhs) {
     if (lhs.rows != rhs.rows || lhs.columns != rhs.columns) {
         throw std::invalid_argument("Matrices must have the same dimensions for subtraction");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.subtract", lhs.n_elements, bytes_of<U>(3ull * lhs.n_elements));
 
-    Matrix<U> result(lhs.rows, lhs.columns);
+    Matrix<U, A> result(lhs.rows, lhs.columns);
     for (int i = 0; i < lhs.n_elements; ++i) {
         result.matrix_data[i] = lhs.matrix_data[i] - rhs.matrix_data[i];
     }
@@ -173,9 +267,9 @@ Matrix<U> operator-(const Matrix<U>& lhs, const Matrix<U>& rhs) {
 }
 
 // Scalar - Matrix
-template <class U>
-Matrix<U> operator-(const U& lhs, const Matrix<U>& rhs) {
-    Matrix<U> result(rhs.rows, rhs.columns);
+template <class U, class A>
+Matrix<U, A> operator-(const U& lhs, const Matrix<U, A>& rhs) {
+    Matrix<U, A> result(rhs.rows, rhs.columns);
     for (int i = 0; i < rhs.n_elements; ++i) {
         result.matrix_data[i] = lhs - rhs.matrix_data[i];
     }
@@ -184,9 +278,9 @@ Matrix<U> operator-(const U& lhs, const Matrix<U>& rhs) {
 }
 
 // Matrix - Scalar
-template <class U>
-Matrix<U> operator-(const Matrix<U>& lhs, const U& rhs) {
-    Matrix<U> result(lhs.rows, lhs.columns);
+template <class U, class A>
+Matrix<U, A> operator-(const Matrix<U, A>& lhs, const U& rhs) {
+    Matrix<U, A> result(lhs.rows, lhs.columns);
     for (int i = 0; i < lhs.n_elements; ++i) {
         result.matrix_data[i] = lhs.matrix_data[i] - rhs;
     }
@@ -195,30 +289,91 @@ Matrix<U> operator-(const Matrix<U>& lhs, const U& rhs) {
 }
 
 // Matrix * Matrix
-template <class U>
-Matrix<U> operator*(const Matrix<U>& lhs, const Matrix<U>& rhs) {
+template <class U, class A>
+Matrix<U, A> operator*(const Matrix<U, A>& lhs, const Matrix<U, A>& rhs) {
     if (lhs.columns != rhs.rows) {
         throw std::invalid_argument("Matrices must have appropriate dimensions for multiplication");
     }
 
-    Matrix<U> result(lhs.rows, rhs.columns);
-    for (int i = 0; i < lhs.rows; ++i) {
-        for (int j = 0; j < rhs.columns; ++j) {
-            U sum = 0;
-            for (int k = 0; k < lhs.columns; ++k) {
-                sum += lhs.get_element(i, k) * rhs.get_element(k, j);
-            }
-            result.set_element(i, j, sum);
-        }
+    Matrix<U, A> result(lhs.rows, rhs.columns);
+    Matrix<U, A>::multiply_into(lhs, rhs, result);
+    return result;
+}
+
+// Matrix * Matrix into a preallocated result
+template <class T, class Alloc>
+void Matrix<T, Alloc>::multiply_into(const Matrix<T, Alloc>& lhs, const Matrix<T, Alloc>& rhs, Matrix<T, Alloc>& result) {
+    multiply_into(lhs, rhs, result, matrix_kernels::ComplexKernel::FourM);
+}
+
+template <class T, class Alloc>
+void Matrix<T, Alloc>::multiply_into(const Matrix<T, Alloc>& lhs, const Matrix<T, Alloc>& rhs, Matrix<T, Alloc>& result,
+                                     matrix_kernels::ComplexKernel kernel) {
+    if (lhs.columns != rhs.rows) {
+        throw std::invalid_argument("Matrices must have appropriate dimensions for multiplication");
+    }
+    if (result.rows != lhs.rows || result.columns != rhs.columns) {
+        throw std::invalid_argument("Result matrix has the wrong dimensions for multiplication");
+    }
+    if (&result == &lhs || &result == &rhs) {
+        throw std::invalid_argument("Result matrix must not alias an operand");
+    }
+
+    // The 3M kernel spends 6 real FLOPs per complex multiply-add instead of 8
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.multiply",
+        (matrix_kernels::is_complex_v<T> && kernel == matrix_kernels::ComplexKernel::ThreeM ? 6 : multiply_add_flops<T>())
+            * std::uint64_t(lhs.rows) * rhs.columns * lhs.columns,
+        bytes_of<T>(std::uint64_t(lhs.rows) * lhs.columns + std::uint64_t(rhs.rows) * rhs.columns
+                    + std::uint64_t(lhs.rows) * rhs.columns));
+
+    // Complex products run on split real/imaginary planes, where the real
+    // kernel vectorizes; interleaved std::complex arithmetic does not
+    if constexpr (matrix_kernels::is_complex_v<T>) {
+        matrix_kernels::complex_gemm(lhs.rows, rhs.columns, lhs.columns,
+                                     lhs.matrix_data, lhs.columns,
+                                     rhs.matrix_data, rhs.columns,
+                                     result.matrix_data, result.columns,
+                                     kernel);
+    } else {
+        (void)kernel;
+        matrix_kernels::gemm(lhs.rows, rhs.columns, lhs.columns,
+                             lhs.matrix_data, lhs.columns,
+                             rhs.matrix_data, rhs.columns,
+                             result.matrix_data, result.columns);
+    }
+}
+
+// Strassen-Winograd Matrix * Matrix
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::strassen_multiply(const Matrix<T, Alloc>& lhs, const Matrix<T, Alloc>& rhs,
+                                       const matrix_kernels::StrassenOptions& options) {
+    if (lhs.columns != rhs.rows) {
+        throw std::invalid_argument("Matrices must have appropriate dimensions for multiplication");
+    }
+
+    // FLOPs are those of the classical product, so GFLOP/s is the effective rate
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.strassen_multiply",
+                             multiply_add_flops<T>() * std::uint64_t(lhs.rows) * rhs.columns * lhs.columns,
+                             bytes_of<T>(3ull * lhs.n_elements));
+
+    Matrix<T, Alloc> result(lhs.rows, rhs.columns);
+    if (lhs.rows != lhs.columns || rhs.rows != rhs.columns) {
+        multiply_into(lhs, rhs, result);
+        return result;
     }
 
+    matrix_kernels::strassen_gemm(lhs.rows,
+                                  lhs.matrix_data, lhs.columns,
+                                  rhs.matrix_data, rhs.columns,
+                                  result.matrix_data, result.columns,
+                                  options);
     return result;
 }
 
 // Scalar * Matrix
-template <class U>
-Matrix<U> operator*(const U& lhs, const Matrix<U>& rhs) {
-    Matrix<U> result(rhs.rows, rhs.columns);
+template <class U, class A>
+Matrix<U, A> operator*(const U& lhs, const Matrix<U, A>& rhs) {
+    Matrix<U, A> result(rhs.rows, rhs.columns);
     for (int i = 0; i < rhs.n_elements; ++i) {
         result.matrix_data[i] = lhs * rhs.matrix_data[i];
     }
@@ -227,15 +382,16 @@ Matrix<U> operator*(const U& lhs, const Matrix<U>& rhs) {
 }
 
 // Matrix * Scalar
-template <class U>
-Matrix<U> operator*(const Matrix<U>& lhs, const U& rhs) {
+template <class U, class A>
+Matrix<U, A> operator*(const Matrix<U, A>& lhs, const U& rhs) {
     return rhs * lhs; 
 }
 
 // Transpose Method
-template <class T>
-Matrix<T> Matrix<T>::transpose() const {
-    Matrix<T> result(columns, rows);
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::transpose() const {
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.transpose", 0, bytes_of<T>(2ull * n_elements));
+    Matrix<T, Alloc> result(columns, rows);
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < columns; ++j) {
             result.set_element(j, i, get_element(i, j));
@@ -244,9 +400,22 @@ Matrix<T> Matrix<T>::transpose() const {
     return result;
 }
 
+// Conjugate transpose
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::conjugate_transpose() const {
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.conjugate_transpose", 0, bytes_of<T>(2ull * n_elements));
+    Matrix<T, Alloc> result(columns, rows);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns; ++j) {
+            result.matrix_data[j * rows + i] = matrix_kernels::conj(matrix_data[sub_to_index(i, j)]);
+        }
+    }
+    return result;
+}
+
 // Determinant Method
-template <class T>
-T Matrix<T>::determinant() const {
+template <class T, class Alloc>
+T Matrix<T, Alloc>::determinant() const {
     if (rows != columns) {
         throw std::invalid_argument("Determinant can only be calculated for square matrices");
     }
@@ -259,10 +428,12 @@ T Matrix<T>::determinant() const {
         return matrix_data[0] * matrix_data[3] - matrix_data[1] * matrix_data[2];
     }
 
+    // Cofactor expansion along the first row; each minor reuses one
+    // scratch matrix from the arena
     T det = 0;
+    ArenaScope scope;
+    Scratch subMatrix(rows - 1, columns - 1);
     for (int i = 0; i < columns; ++i) {
-        Matrix<T> subMatrix(rows - 1, columns - 1);
-
         for (int subRow = 1; subRow < rows; ++subRow) {
             int subColIndex = 0;
             for (int subCol = 0; subCol < columns; ++subCol) {
@@ -273,45 +444,59 @@ T Matrix<T>::determinant() const {
         }
 
         T subDet = subMatrix.determinant();
-        det += (i % 2 == 0 ? 1 : -1) * matrix_data[i] * subDet;
+        const T sign = (i % 2 == 0) ? T(1) : T(-1);
+        det += sign * matrix_data[i] * subDet;
     }
     return det;
 }
 
 // Inverse Method
-template <class T>
-Matrix<T> Matrix<T>::inverse() const {
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::inverse() const {
     if (rows != columns) {
         throw std::invalid_argument("Inverse can only be calculated for square matrices");
     }
+    // Cofactor expansion has no meaningful FLOP count; only time is recorded
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.inverse", 0, bytes_of<T>(2ull * n_elements));
 
     T det = determinant();
-    if (det == 0) {
+    if (det == T(0)) {
         throw std::runtime_error("Matrix is singular and cannot be inverted");
     }
 
-    Matrix<T> adjoint(rows, columns);
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < columns; ++j) {
-            Matrix<T> subMatrix(rows - 1, columns - 1);
-            for (int subRow = 0; subRow < rows; ++subRow) {
-                if (subRow == i) continue;
-                int subColIndex = 0;
-                for (int subCol = 0; subCol < columns; ++subCol) {
-                    if (subCol == j) continue;
-                    subMatrix.set_element(subRow < i ? subRow : subRow - 1, subColIndex, get_element(subRow, subCol));
-                    ++subColIndex;
+    // The result is allocated before the scratch scope opens so that it
+    // outlives the scope even when Alloc is itself an arena allocator
+    Matrix<T, Alloc> adjoint(rows, columns);
+    {
+        ArenaScope scope;
+        Scratch subMatrix(rows - 1, columns - 1);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < columns; ++j) {
+                for (int subRow = 0; subRow < rows; ++subRow) {
+                    if (subRow == i) continue;
+                    int subColIndex = 0;
+                    for (int subCol = 0; subCol < columns; ++subCol) {
+                        if (subCol == j) continue;
+                        subMatrix.set_element(subRow < i ? subRow : subRow - 1, subColIndex, get_element(subRow, subCol));
+                        ++subColIndex;
+                    }
                 }
+                const T sign = ((i + j) % 2 == 0) ? T(1) : T(-1);
+                adjoint.set_element(j, i, sign * subMatrix.determinant());
             }
-            adjoint.set_element(j, i, ((i + j) % 2 == 0 ? 1 : -1) * subMatrix.determinant());
         }
     }
-    return (1 / det) * adjoint;
+
+    T inv_det = T(1) / det;
+    for (int i = 0; i < n_elements; ++i) {
+        adjoint.matrix_data[i] = inv_det * adjoint.matrix_data[i];
+    }
+    return adjoint;
 }
 
 // Trace Method
-template <class T>
-T Matrix<T>::trace() const {
+template <class T, class Alloc>
+T Matrix<T, Alloc>::trace() const {
     if (rows != columns) {
         throw std::invalid_argument("Trace can only be calculated for square matrices");
     }
@@ -324,25 +509,25 @@ T Matrix<T>::trace() const {
 }
 
 // Fill Method
-template <class T>
-void Matrix<T>::fill(T value) {
+template <class T, class Alloc>
+void Matrix<T, Alloc>::fill(T value) {
     for (int i = 0; i < n_elements; ++i) {
         matrix_data[i] = value;
     }
 }
 
 // Create a Zero Matrix
-template <class T>
-Matrix<T> Matrix<T>::zero_matrix(int n, int m) {
-    Matrix<T> result(n, m);
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::zero_matrix(int n, int m) {
+    Matrix<T, Alloc> result(n, m);
     result.fill(0);
     return result;
 }
 
 // Create an Identity Matrix
-template <class T>
-Matrix<T> Matrix<T>::identity_matrix(int n) {
-    Matrix<T> result(n, n);
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::identity_matrix(int n) {
+    Matrix<T, Alloc> result(n, n);
     for (int i = 0; i < n; ++i) {
         result.set_element(i, i, 1);
     }
@@ -350,10 +535,10 @@ Matrix<T> Matrix<T>::identity_matrix(int n) {
 }
 
 // Create a Diagonal Matrix
-template <class T>
-Matrix<T> Matrix<T>::diagonal_matrix(const std::vector<T>& diag_elements) {
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::diagonal_matrix(const std::vector<T>& diag_elements) {
     int n = diag_elements.size();
-    Matrix<T> result(n, n);
+    Matrix<T, Alloc> result(n, n);
     for (int i = 0; i < n; ++i) {
         result.set_element(i, i, diag_elements[i]);
     }
@@ -361,77 +546,124 @@ Matrix<T> Matrix<T>::diagonal_matrix(const std::vector<T>& diag_elements) {
 }
 
 // QR Decomposition
-template <class T>
-Matrix<T> Matrix<T>::QRDecomposition(Matrix<T>& Q, Matrix<T>& R) const {
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::QRDecomposition(Matrix<T, Alloc>& Q, Matrix<T, Alloc>& R) const {
+    householder_qr(Q, R);
+    return R;
+}
+
+// Householder QR into caller-provided Q and R
+// Q and R are only reallocated when their shapes are wrong, and that
+// happens before the scratch scope opens
+template <class T, class Alloc>
+void Matrix<T, Alloc>::householder_qr(Matrix<T, Alloc>& Q, Matrix<T, Alloc>& R) const {
     int n = rows;
+    // About 2/3 n^3 multiply-adds update R and n^3 accumulate Q
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.qr", multiply_add_flops<T>() * 5ull * n * n * n / 3,
+                             bytes_of<T>(3ull * n_elements));
 
-    Q = Matrix<T>::identity_matrix(n);
-    R = *this;
+    if (Q.rows != n || Q.columns != n) {
+        Q.resize(n, n);
+    }
+    Q.fill(0);
+    for (int i = 0; i < n; ++i) {
+        Q.set_element(i, i, 1);
+    }
+    if (R.rows != rows || R.columns != columns) {
+        R.resize(rows, columns);
+    }
+    std::copy(matrix_data, matrix_data + n_elements, R.matrix_data);
+
+    ArenaScope scope;
+    std::vector<T, ArenaAllocator<T>> u(n, T(0));
 
     for (int k = 0; k < n - 1; ++k) {
-        T norm_x = 0;
+        real_type norm_x = 0;
         for (int i = k; i < n; ++i) {
-            norm_x += R.get_element(i, k) * R.get_element(i, k);
+            norm_x += std::norm(R.get_element(i, k));
         }
         norm_x = std::sqrt(norm_x);
-
-        if (R.get_element(k, k) < 0) {
-            norm_x = -norm_x;
-        }
-
-        T rkk = std::sqrt(0.5 * (norm_x * norm_x - R.get_element(k, k) * norm_x));
-        if (rkk == 0) {
+        if (norm_x == 0) {
             continue;
         }
 
-        std::vector<T> u(n, 0);
-        u[k] = (R.get_element(k, k) - norm_x) / (2 * rkk);
+        // Reflect x onto alpha e_1 with alpha = -(x_k / |x_k|) ||x||, so that
+        // x_k - alpha never cancels. For real T the phase is sign(x_k).
+        const T x_k = R.get_element(k, k);
+        const real_type abs_x_k = std::abs(x_k);
+        const T alpha = abs_x_k == 0 ? T(-norm_x) : -(x_k / abs_x_k) * norm_x;
+
+        u[k] = x_k - alpha;
         for (int i = k + 1; i < n; ++i) {
-            u[i] = R.get_element(i, k) / (2 * rkk);
+            u[i] = R.get_element(i, k);
+        }
+        real_type norm_u = 0;
+        for (int i = k; i < n; ++i) {
+            norm_u += std::norm(u[i]);
+        }
+        norm_u = std::sqrt(norm_u);
+        if (norm_u == 0) {
+            continue;
+        }
+        for (int i = k; i < n; ++i) {
+            u[i] /= norm_u;
         }
 
+        // H = I - 2 u u^H applied from the left to R and to Q
         for (int j = k; j < n; ++j) {
             T sum = 0;
             for (int i = k; i < n; ++i) {
-                sum += u[i] * R.get_element(i, j);
+                sum += matrix_kernels::conj(u[i]) * R.get_element(i, j);
             }
             for (int i = k; i < n; ++i) {
-                R.set_element(i, j, R.get_element(i, j) - 2 * u[i] * sum);
+                R.set_element(i, j, R.get_element(i, j) - T(2) * u[i] * sum);
             }
         }
 
         for (int j = 0; j < n; ++j) {
             T sum = 0;
             for (int i = k; i < n; ++i) {
-                sum += u[i] * Q.get_element(i, j);
+                sum += matrix_kernels::conj(u[i]) * Q.get_element(i, j);
             }
             for (int i = k; i < n; ++i) {
-                Q.set_element(i, j, Q.get_element(i, j) - 2 * u[i] * sum);
+                Q.set_element(i, j, Q.get_element(i, j) - T(2) * u[i] * sum);
             }
         }
     }
 
-    Q = Q.transpose();
-    return R;
+    // Q holds the product of the reflections; the factor is its conjugate transpose
+    for (int i = 0; i < n; ++i) {
+        Q.matrix_data[i * n + i] = matrix_kernels::conj(Q.matrix_data[i * n + i]);
+        for (int j = i + 1; j < n; ++j) {
+            T upper = Q.matrix_data[i * n + j];
+            Q.matrix_data[i * n + j] = matrix_kernels::conj(Q.matrix_data[j * n + i]);
+            Q.matrix_data[j * n + i] = matrix_kernels::conj(upper);
+        }
+    }
 }
 
 // QR Algorithm to compute all eigenvalues
-template <class T>
-std::vector<T> Matrix<T>::eigenvalues() const {
+template <class T, class Alloc>
+std::vector<T> Matrix<T, Alloc>::eigenvalues() const {
     if (rows != columns) {
         throw std::invalid_argument("Eigenvalues can only be calculated for square matrices");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.eigenvalues", 0, bytes_of<T>(n_elements));
+
+    std::vector<T> eigenvalues;
+    eigenvalues.reserve(rows);
 
-    Matrix<T> A = *this;
-    Matrix<T> Q(rows, columns);
-    Matrix<T> R(rows, columns);
+    ArenaScope scope;
+    Scratch A(rows, columns, matrix_data);
+    Scratch Q(rows, columns);
+    Scratch R(rows, columns);
 
     const int max_iter = 1000;
-    const T tol = 1e-10;
+    const real_type tol = real_type(1e-10);
 
     for (int iter = 0; iter < max_iter; ++iter) {
-        A.QRDecomposition(Q, R);
-        A = R * Q;
+        A.householder_qr(Q, R);
+        Scratch::multiply_into(R, Q, A);
 
         bool is_converged = true;
         for (int i = 0; i < rows - 1; ++i) {
@@ -446,7 +678,6 @@ std::vector<T> Matrix<T>::eigenvalues() const {
         }
     }
 
-    std::vector<T> eigenvalues;
     for (int i = 0; i < rows; ++i) {
         eigenvalues.push_back(A.get_element(i, i));
     }
@@ -454,25 +685,154 @@ std::vector<T> Matrix<T>::eigenvalues() const {
     return eigenvalues;
 }
 
-template <class T>
-Matrix<T> Matrix<T>::CholeskyDecomposition() const {
+namespace {
+
+// Cyclic Jacobi on a real symmetric n x n row-major matrix. A is
+// overwritten; on return its diagonal holds the eigenvalues. Returns the
+// number of rotations applied.
+template <class R>
+std::uint64_t symmetric_jacobi(R* A, int n) {
+    std::uint64_t rotations = 0;
+    const int max_sweeps = 100;
+    for (int sweep = 0; sweep < max_sweeps; ++sweep) {
+        R off = 0, total = 0;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                total += A[i * n + j] * A[i * n + j];
+                if (i != j) off += A[i * n + j] * A[i * n + j];
+            }
+        }
+        if (off <= std::numeric_limits<R>::epsilon() * std::numeric_limits<R>::epsilon() * total) {
+            return rotations;
+        }
+
+        for (int p = 0; p < n - 1; ++p) {
+            for (int q = p + 1; q < n; ++q) {
+                const R apq = A[p * n + q];
+                if (apq == 0) continue;
+
+                // Rotation that annihilates A(p, q) (Golub & Van Loan, 8.5.2)
+                const R theta = (A[q * n + q] - A[p * n + p]) / (2 * apq);
+                const R t = (theta >= 0 ? R(1) : R(-1)) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                const R c = 1 / std::sqrt(t * t + 1);
+                const R s = t * c;
+                ++rotations;
+
+                for (int k = 0; k < n; ++k) {
+                    const R akp = A[k * n + p], akq = A[k * n + q];
+                    A[k * n + p] = c * akp - s * akq;
+                    A[k * n + q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < n; ++k) {
+                    const R apk = A[p * n + k], aqk = A[q * n + k];
+                    A[p * n + k] = c * apk - s * aqk;
+                    A[q * n + k] = s * apk + c * aqk;
+                }
+            }
+        }
+    }
+    return rotations;
+}
+
+}
+
+// Eigenvalues of a symmetric / Hermitian matrix
+// A complex Hermitian H = X + iY is handed to the real Jacobi solver as the
+// symmetric embedding [X -Y; Y X], whose spectrum is that of H with every
+// eigenvalue doubled
+template <class T, class Alloc>
+std::vector<typename Matrix<T, Alloc>::real_type> Matrix<T, Alloc>::hermitian_eigenvalues() const {
+    if (rows != columns) {
+        throw std::invalid_argument("Eigenvalues can only be calculated for square matrices");
+    }
+
+    if constexpr (std::is_integral_v<T>) {
+        throw std::invalid_argument("Hermitian eigenvalues require a floating-point matrix");
+    } else {
+        using R = real_type;
+        const int n = rows;
+
+        R scale = 0, asymmetry = 0;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                scale = std::max(scale, std::abs(matrix_data[i * n + j]));
+                asymmetry = std::max(asymmetry, std::abs(matrix_data[i * n + j] - matrix_kernels::conj(matrix_data[j * n + i])));
+            }
+        }
+        if (asymmetry > R(1e3) * std::numeric_limits<R>::epsilon() * scale) {
+            throw std::invalid_argument("Matrix is not symmetric / Hermitian");
+        }
+
+        NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.hermitian_eigenvalues", 0, bytes_of<T>(n_elements));
+        std::vector<R> eigenvalues(n);
+        ArenaScope scope;
+
+        if constexpr (matrix_kernels::is_complex_v<T>) {
+            const int m = 2 * n;
+            std::vector<R, ArenaAllocator<R>> E(static_cast<std::size_t>(m) * m);
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    const R x = matrix_data[i * n + j].real();
+                    const R y = matrix_data[i * n + j].imag();
+                    E[i * m + j] = x;
+                    E[i * m + (j + n)] = -y;
+                    E[(i + n) * m + j] = y;
+                    E[(i + n) * m + (j + n)] = x;
+                }
+            }
+            [[maybe_unused]] const std::uint64_t rotations = symmetric_jacobi(E.data(), m);
+            NUMERIC_INSTRUMENT_ADD(probe, 12 * rotations * m, 0);
+
+            std::vector<R, ArenaAllocator<R>> doubled(m);
+            for (int i = 0; i < m; ++i) {
+                doubled[i] = E[i * m + i];
+            }
+            std::sort(doubled.begin(), doubled.end());
+            for (int i = 0; i < n; ++i) {
+                eigenvalues[i] = doubled[2 * i];
+            }
+        } else {
+            std::vector<R, ArenaAllocator<R>> E(matrix_data, matrix_data + n_elements);
+            [[maybe_unused]] const std::uint64_t rotations = symmetric_jacobi(E.data(), n);
+            NUMERIC_INSTRUMENT_ADD(probe, 12 * rotations * n, 0);
+            for (int i = 0; i < n; ++i) {
+                eigenvalues[i] = E[i * n + i];
+            }
+            std::sort(eigenvalues.begin(), eigenvalues.end());
+        }
+
+        return eigenvalues;
+    }
+}
+
+// Cholesky-Banachiewicz, A = L L^H
+// For Hermitian A the diagonal of A - L L^H is real, so only its real
+// part goes under the square root
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::CholeskyDecomposition() const {
     if (rows != columns) {
         throw std::invalid_argument("Cholesky Decomposition requires a square matrix");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.cholesky", multiply_add_flops<T>() * std::uint64_t(rows) * rows * rows / 6,
+                             bytes_of<T>(2ull * n_elements));
 
-    Matrix<T> L(rows, columns);
+    Matrix<T, Alloc> L(rows, columns);
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j <= i; ++j) {
-            T sum = 0;  // This will hold the sum of L(i, k) * L(j, k) for k = 0 to j-1
+            T sum = 0;  // This will hold the sum of L(i, k) * conj(L(j, k)) for k = 0 to j-1
 
-            // Sum of L(i, k) * L(j, k) for all k < j
+            // Sum of L(i, k) * conj(L(j, k)) for all k < j
             for (int k = 0; k < j; ++k) {
-                sum += L.get_element(i, k) * L.get_element(j, k);
+                sum += L.get_element(i, k) * matrix_kernels::conj(L.get_element(j, k));
             }
 
             // For diagonal elements (i == j), calculate L(i, j) = sqrt(A(i, i) - sum)
             if (i == j) {
-                L.set_element(i, j, std::sqrt(get_element(i, i) - sum));
+                if constexpr (matrix_kernels::is_complex_v<T>) {
+                    L.set_element(i, j, T(std::sqrt(std::real(get_element(i, i) - sum))));
+                } else {
+                    L.set_element(i, j, std::sqrt(get_element(i, i) - sum));
+                }
             }
             // For off-diagonal elements, calculate L(i, j) = (A(i, j) - sum) / L(j, j)
             else {
@@ -484,34 +844,200 @@ Matrix<T> Matrix<T>::CholeskyDecomposition() const {
     return L;
 }
 
-template <class T>
-Matrix<T> Matrix<T>::power(int exponent) const {
+// Exponentiation by squaring
+// result, base and one scratch buffer are allocated up front; every
+// multiply writes into the scratch buffer, which is then swapped in
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::power(int exponent) const {
     if (rows != columns) {
         throw std::invalid_argument("Matrix exponentiation requires a square matrix");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.power", 0, bytes_of<T>(n_elements));
 
-    Matrix<T> result = Matrix<T>::identity_matrix(rows);
-    Matrix<T> base = *this;
+    Matrix<T, Alloc> result = Matrix<T, Alloc>::identity_matrix(rows);
+    Matrix<T, Alloc> base = *this;
+    Matrix<T, Alloc> scratch(rows, columns);
 
     while (exponent > 0) {
         if (exponent % 2 == 1) {
-            result = result * base;
+            multiply_into(result, base, scratch);
+            result.swap(scratch);
         }
-        base = base * base;
         exponent /= 2;
+        if (exponent > 0) {
+            multiply_into(base, base, scratch);
+            base.swap(scratch);
+        }
     }
 
     return result;
 }
 
+namespace {
+
+// Coefficients of the [m/m] Padé approximant to e^x (Higham, 2005)
+constexpr double pade3[] = {120.0, 60.0, 12.0, 1.0};
+constexpr double pade5[] = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+constexpr double pade7[] = {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+constexpr double pade9[] = {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+                            2162160.0, 110880.0, 3960.0, 90.0, 1.0};
+constexpr double pade13[] = {64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+                             1187353796428800.0, 129060195264000.0, 10559470521600.0,
+                             670442572800.0, 33522128640.0, 1323241920.0, 40840800.0,
+                             960960.0, 16380.0, 182.0, 1.0};
+
+// Largest 1-norm for which each approximant of degree 3, 5, 7, 9, 13 is
+// accurate to double precision; the last one is also the scaling target
+constexpr double theta_double[] = {1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1,
+                                   2.097847961257068e0, 5.371920351148152e0};
+// Single precision needs degree 7 at most (Higham, 2005, Table 2.1)
+constexpr double theta_single[] = {4.258730016922831e-1, 1.880152677804762e0, 3.925724783138660e0};
+
+}
+
+// Matrix exponential
+// Scaling and squaring with a Padé approximant of degree 3, 5, 7, 9 or 13
+// chosen from the 1-norm (at most 7 for float and std::complex<float>).
+// All products go through multiply_into on a fixed set of workspaces, so
+// no allocation happens inside the squaring loop.
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::expm() const {
+    if (rows != columns) {
+        throw std::invalid_argument("Matrix exponential requires a square matrix");
+    }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.expm", 0, bytes_of<T>(2ull * n_elements));
+
+    if constexpr (std::is_integral_v<T>) {
+        throw std::invalid_argument("Matrix exponential requires a floating-point matrix");
+    } else {
+        const int n = rows;
+
+        double norm1 = 0.0;
+        for (int j = 0; j < n; ++j) {
+            double col_sum = 0.0;
+            for (int i = 0; i < n; ++i) {
+                col_sum += std::abs(matrix_data[sub_to_index(i, j)]);
+            }
+            norm1 = std::max(norm1, col_sum);
+        }
+
+        // Degree and scaling from the θ table of the precision of T
+        using Real = decltype(std::abs(std::declval<T>()));
+        constexpr bool single = sizeof(Real) <= sizeof(float);
+        const double* theta = single ? theta_single : theta_double;
+        const double* approximants[] = {pade3, pade5, pade7, pade9, pade13};
+        const int degrees[] = {3, 5, 7, 9, 13};
+        const int count = single ? 3 : 5;
+
+        int squarings = 0;
+        int choice = 0;
+        while (choice < count - 1 && norm1 > theta[choice]) ++choice;
+        if (norm1 > theta[count - 1]) {
+            squarings = std::max(0, static_cast<int>(std::ceil(std::log2(norm1 / theta[count - 1]))));
+        }
+        const double* b = approximants[choice];
+        const int degree = degrees[choice];
+
+        // Workspaces come from the arena; only the result is allocated with Alloc
+        Matrix<T, Alloc> result(n, n);
+        ArenaScope scope;
+
+        Scratch A(n, n, matrix_data);
+        if (squarings > 0) {
+            const T scale = T(1) / static_cast<T>(std::ldexp(1.0, squarings));
+            for (int i = 0; i < n_elements; ++i) {
+                A.matrix_data[i] *= scale;
+            }
+        }
+
+        Scratch A2(n, n), A4(n, n), A6(n, n);
+        Scratch U(n, n), V(n, n), scratch(n, n);
+        Scratch::multiply_into(A, A, A2);
+
+        // Even powers needed by the chosen degree
+        if (degree >= 5) Scratch::multiply_into(A2, A2, A4);
+        if (degree >= 7) Scratch::multiply_into(A4, A2, A6);
+
+        if (degree == 13) {
+            // U = A [A6 (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I]
+            // V = A6 (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I
+            for (int i = 0; i < n_elements; ++i) {
+                V.matrix_data[i] = T(b[13]) * A6.matrix_data[i] + T(b[11]) * A4.matrix_data[i]
+                                 + T(b[9]) * A2.matrix_data[i];
+            }
+            Scratch::multiply_into(A6, V, scratch);
+            for (int i = 0; i < n_elements; ++i) {
+                scratch.matrix_data[i] += T(b[7]) * A6.matrix_data[i] + T(b[5]) * A4.matrix_data[i]
+                                        + T(b[3]) * A2.matrix_data[i];
+            }
+            for (int i = 0; i < n; ++i) {
+                scratch.matrix_data[sub_to_index(i, i)] += T(b[1]);
+            }
+            Scratch::multiply_into(A, scratch, U);
+
+            for (int i = 0; i < n_elements; ++i) {
+                scratch.matrix_data[i] = T(b[12]) * A6.matrix_data[i] + T(b[10]) * A4.matrix_data[i]
+                                       + T(b[8]) * A2.matrix_data[i];
+            }
+            Scratch::multiply_into(A6, scratch, V);
+            for (int i = 0; i < n_elements; ++i) {
+                V.matrix_data[i] += T(b[6]) * A6.matrix_data[i] + T(b[4]) * A4.matrix_data[i]
+                                  + T(b[2]) * A2.matrix_data[i];
+            }
+            for (int i = 0; i < n; ++i) {
+                V.matrix_data[sub_to_index(i, i)] += T(b[0]);
+            }
+        } else {
+            // U = A (sum of odd terms), V = sum of even terms; degree 9 needs A8
+            Scratch A8(degree == 9 ? n : 1, degree == 9 ? n : 1);
+            if (degree == 9) Scratch::multiply_into(A4, A4, A8);
+            const Scratch* even_powers[] = {nullptr, &A2, &A4, &A6, &A8};
+
+            scratch.fill(T(0));
+            V.fill(T(0));
+            for (int i = 0; i < n; ++i) {
+                scratch.matrix_data[sub_to_index(i, i)] = T(b[1]);
+                V.matrix_data[sub_to_index(i, i)] = T(b[0]);
+            }
+            for (int p = 1; 2 * p <= degree; ++p) {
+                const Scratch& Ap = *even_powers[p];
+                for (int i = 0; i < n_elements; ++i) {
+                    scratch.matrix_data[i] += T(b[2 * p + 1]) * Ap.matrix_data[i];
+                    V.matrix_data[i] += T(b[2 * p]) * Ap.matrix_data[i];
+                }
+            }
+            Scratch::multiply_into(A, scratch, U);
+        }
+
+        // Solve (V - U) X = (V + U); the result lands in scratch
+        for (int i = 0; i < n_elements; ++i) {
+            scratch.matrix_data[i] = V.matrix_data[i] + U.matrix_data[i];
+            V.matrix_data[i] -= U.matrix_data[i];
+        }
+        std::vector<int, ArenaAllocator<int>> piv(n);
+        matrix_kernels::lu_factor(V.matrix_data, n, piv.data());
+        matrix_kernels::lu_solve(V.matrix_data, piv.data(), n, scratch.matrix_data, n);
+
+        // Undo the scaling: X <- X^2, ping-ponging between scratch and U
+        for (int s = 0; s < squarings; ++s) {
+            Scratch::multiply_into(scratch, scratch, U);
+            scratch.swap(U);
+        }
+
+        std::copy(scratch.matrix_data, scratch.matrix_data + n_elements, result.matrix_data);
+        return result;
+    }
+}
+
 // Product-wise multiplication
-template <class T>
-Matrix<T> Matrix<T>::hadamard_product(const Matrix<T>& other) const {
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::hadamard_product(const Matrix<T, Alloc>& other) const {
     if (rows != other.rows || columns != other.columns) {
         throw std::invalid_argument("Matrices must have the same dimensions for Hadamard product");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "matrix.hadamard_product", n_elements, bytes_of<T>(3ull * n_elements));
 
-    Matrix<T> result(rows, columns);
+    Matrix<T, Alloc> result(rows, columns);
     for (int i = 0; i < n_elements; ++i) {
         result.matrix_data[i] = matrix_data[i] * other.matrix_data[i];
     }
@@ -519,9 +1045,9 @@ Matrix<T> Matrix<T>::hadamard_product(const Matrix<T>& other) const {
     return result;
 }
 
-template <class T>
-Matrix<T> Matrix<T>::operator-() const {
-    Matrix<T> result(rows, columns);
+template <class T, class Alloc>
+Matrix<T, Alloc> Matrix<T, Alloc>::operator-() const {
+    Matrix<T, Alloc> result(rows, columns);
     for (int i = 0; i < n_elements; ++i) {
         result.matrix_data[i] = -matrix_data[i];
     }
@@ -531,3 +1057,34 @@ Matrix<T> Matrix<T>::operator-() const {
 template class Matrix<int>;
 template class Matrix<float>;
 template class Matrix<double>;
+template class Matrix<int, ArenaAllocator<int>>;
+template class Matrix<float, ArenaAllocator<float>>;
+template class Matrix<double, ArenaAllocator<double>>;
+template class Matrix<std::complex<float>>;
+template class Matrix<std::complex<double>>;
+template class Matrix<std::complex<float>, ArenaAllocator<std::complex<float>>>;
+template class Matrix<std::complex<double>, ArenaAllocator<std::complex<double>>>;
+
+// The friend operators are templates defined in this file, so they need
+// explicit instantiations of their own
+#define INSTANTIATE_MATRIX_OPERATORS(U, A)                                     \
+    template Matrix<U, A> operator+ (const Matrix<U, A>&, const Matrix<U, A>&); \
+    template Matrix<U, A> operator+ (const U&, const Matrix<U, A>&);           \
+    template Matrix<U, A> operator+ (const Matrix<U, A>&, const U&);           \
+    template Matrix<U, A> operator- (const Matrix<U, A>&, const Matrix<U, A>&); \
+    template Matrix<U, A> operator- (const U&, const Matrix<U, A>&);           \
+    template Matrix<U, A> operator- (const Matrix<U, A>&, const U&);           \
+    template Matrix<U, A> operator* (const Matrix<U, A>&, const Matrix<U, A>&); \
+    template Matrix<U, A> operator* (const U&, const Matrix<U, A>&);           \
+    template Matrix<U, A> operator* (const Matrix<U, A>&, const U&);
+
+INSTANTIATE_MATRIX_OPERATORS(int, std::allocator<int>)
+INSTANTIATE_MATRIX_OPERATORS(float, std::allocator<float>)
+INSTANTIATE_MATRIX_OPERATORS(double, std::allocator<double>)
+INSTANTIATE_MATRIX_OPERATORS(int, ArenaAllocator<int>)
+INSTANTIATE_MATRIX_OPERATORS(float, ArenaAllocator<float>)
+INSTANTIATE_MATRIX_OPERATORS(double, ArenaAllocator<double>)
+INSTANTIATE_MATRIX_OPERATORS(std::complex<float>, std::allocator<std::complex<float>>)
+INSTANTIATE_MATRIX_OPERATORS(std::complex<double>, std::allocator<std::complex<double>>)
+INSTANTIATE_MATRIX_OPERATORS(std::complex<float>, ArenaAllocator<std::complex<float>>)
+INSTANTIATE_MATRIX_OPERATORS(std::complex<double>, ArenaAllocator<std::complex<double>>)
@@ -1,77 +1,126 @@
 #pragma once
 
 #include <algorithm> 
+#include <cmath>
 #include <vector>
 #include <stdexcept>
 #include <complex>
+#include <memory>
+#include <utility>
 
-template <class T>
+#include "MatrixArena.h"
+#include "MatrixKernels.h"
+#include "Strassen.h"
+
+// Alloc is the allocator policy for the element buffer. Algorithms that
+// need temporaries build them as Matrix<T, ArenaAllocator<T>> inside an
+// ArenaScope, so their scratch memory comes from the thread's MatrixArena.
+template <class T, class Alloc = std::allocator<T>>
 class Matrix{
     public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    // Type of |x| for an element x: R for std::complex<R>, T otherwise
+    using real_type = decltype(std::abs(std::declval<T>()));
+
     // Constructors
     Matrix();
     Matrix(int rows, int columns);
     Matrix(int rows, int columns, const T* input_data);
-    Matrix(const Matrix<T>& input_Matrix);
+    Matrix(const Matrix<T, Alloc>& input_Matrix);
+    Matrix(Matrix<T, Alloc>&& input_Matrix) noexcept;
 
     ~Matrix();
+
+    // Assignment reuses the existing buffer when the shapes match
+    Matrix<T, Alloc>& operator= (const Matrix<T, Alloc>& rhs);
+    Matrix<T, Alloc>& operator= (Matrix<T, Alloc>&& rhs) noexcept;
+    void swap(Matrix<T, Alloc>& other) noexcept;
+
     // Succesful or not succesful resizing of matrix
     bool resize (int nRows, int nColumns);
     
     // Access methods
-    T get_element (int row, int column);
+    T get_element (int row, int column) const;
     bool set_element (int row, int column, T element_value);
-    int get_num_rows();
-    int get_num_cols();
+    int get_num_rows() const;
+    int get_num_cols() const;
+    T* data() { return matrix_data; }
+    const T* data() const { return matrix_data; }
 
     // Operations
     // Equality
-    bool operator== (const Matrix<T> & rhs);
+    bool operator== (const Matrix<T, Alloc> & rhs);
 
     // Sum of matrices
-    template <class U> friend Matrix<U> operator+ (const Matrix<U>& lhs, const Matrix<U>& rhs);
-    template <class U> friend Matrix<U> operator+ (const U& lhs, const Matrix<U>& rhs);
-    template <class U> friend Matrix<U> operator+ (const Matrix<U>& lhs, const U& rhs);
+    template <class U, class A> friend Matrix<U, A> operator+ (const Matrix<U, A>& lhs, const Matrix<U, A>& rhs);
+    template <class U, class A> friend Matrix<U, A> operator+ (const U& lhs, const Matrix<U, A>& rhs);
+    template <class U, class A> friend Matrix<U, A> operator+ (const Matrix<U, A>& lhs, const U& rhs);
 
     // Difference of matrices
-    template <class U> friend Matrix<U> operator- (const Matrix<U>& lhs, const Matrix<U>& rhs);
-    template <class U> friend Matrix<U> operator- (const U& lhs, const Matrix<U>& rhs);
-    template <class U> friend Matrix<U> operator- (const Matrix<U>& lhs, const U& rhs);
+    template <class U, class A> friend Matrix<U, A> operator- (const Matrix<U, A>& lhs, const Matrix<U, A>& rhs);
+    template <class U, class A> friend Matrix<U, A> operator- (const U& lhs, const Matrix<U, A>& rhs);
+    template <class U, class A> friend Matrix<U, A> operator- (const Matrix<U, A>& lhs, const U& rhs);
 
     // Product of matrices
-    template <class U> friend Matrix<U> operator* (const Matrix<U>& lhs, const Matrix<U>& rhs);
-    template <class U> friend Matrix<U> operator* (const U& lhs, const Matrix<U>& rhs);
-    template <class U> friend Matrix<U> operator* (const Matrix<U>& lhs, const U& rhs);
+    template <class U, class A> friend Matrix<U, A> operator* (const Matrix<U, A>& lhs, const Matrix<U, A>& rhs);
+    // result = lhs * rhs without allocating; result must already have the right shape
+    static void multiply_into(const Matrix<T, Alloc>& lhs, const Matrix<T, Alloc>& rhs, Matrix<T, Alloc>& result);
+    // Same, choosing the complex kernel (4M or 3M); real T ignores the choice
+    static void multiply_into(const Matrix<T, Alloc>& lhs, const Matrix<T, Alloc>& rhs, Matrix<T, Alloc>& result,
+                              matrix_kernels::ComplexKernel kernel);
+    // Strassen-Winograd product for large square operands; other shapes use the classical kernel
+    static Matrix<T, Alloc> strassen_multiply(const Matrix<T, Alloc>& lhs, const Matrix<T, Alloc>& rhs,
+                                       const matrix_kernels::StrassenOptions& options = {});
+    template <class U, class A> friend Matrix<U, A> operator* (const U& lhs, const Matrix<U, A>& rhs);
+    template <class U, class A> friend Matrix<U, A> operator* (const Matrix<U, A>& lhs, const U& rhs);
 
-    Matrix<T> transpose() const;
+    Matrix<T, Alloc> transpose() const;
+    // A^H; equal to transpose() for real T
+    Matrix<T, Alloc> conjugate_transpose() const;
     T determinant() const;
-    Matrix<T> inverse() const;
+    Matrix<T, Alloc> inverse() const;
     T trace() const;
     void fill(T value);
-    Matrix<T> operator-() const;
+    Matrix<T, Alloc> operator-() const;
 
-    static Matrix<T> zero_matrix(int n, int m);
-    static Matrix<T> identity_matrix(int n);
-    static Matrix<T> diagonal_matrix(const std::vector<T>& diag_elements);
+    static Matrix<T, Alloc> zero_matrix(int n, int m);
+    static Matrix<T, Alloc> identity_matrix(int n);
+    static Matrix<T, Alloc> diagonal_matrix(const std::vector<T>& diag_elements);
 
     std::vector<T> eigenvalues() const;
+    // Eigenvalues of a symmetric / Hermitian matrix in ascending order (Jacobi)
+    std::vector<real_type> hermitian_eigenvalues() const;
 
-    Matrix<T> CholeskyDecomposition() const;
-    Matrix<T> power(int exponent) const;
-    Matrix<T> hadamard_product(const Matrix<T>& other) const;
-    Matrix<T> QRDecomposition(Matrix<T>& Q, Matrix<T>& R) const;
+    // Lower-triangular L with A = L L^H; A must be symmetric / Hermitian positive definite
+    Matrix<T, Alloc> CholeskyDecomposition() const;
+    Matrix<T, Alloc> power(int exponent) const;
+    // Matrix exponential e^A (Padé scaling-and-squaring)
+    Matrix<T, Alloc> expm() const;
+    Matrix<T, Alloc> hadamard_product(const Matrix<T, Alloc>& other) const;
+    Matrix<T, Alloc> QRDecomposition(Matrix<T, Alloc>& Q, Matrix<T, Alloc>& R) const;
 
-    double& operator()(int row, int col) {
+    T& operator()(int row, int col) {
         return matrix_data[sub_to_index(row, col)];
     }
 
-    const double& operator()(int row, int col) const {
+    const T& operator()(int row, int col) const {
         return matrix_data[sub_to_index(row, col)];
     }
 
     private:
+    // Matrices with other allocators are used as scratch space
+    template <class, class> friend class Matrix;
+
+    // Scratch matrix type for temporaries inside algorithms
+    using Scratch = Matrix<T, ArenaAllocator<T>>;
+
     int sub_to_index(int row, int col) const;
+    void householder_qr(Matrix<T, Alloc>& Q, Matrix<T, Alloc>& R) const;
+    T* allocate_elements(int count);
+    void deallocate_elements();
 
     int rows, columns, n_elements;
     T* matrix_data;
+    Alloc allocator;
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Thread-local bump arena for the scratch storage of Matrix algorithms.
+//
+// Memory comes from a list of blocks that are never returned to the heap;
+// allocating bumps an offset, and an ArenaScope rewinds the offset to where
+// it was when the scope opened. Once the blocks are large enough for a
+// workload, repeating that workload performs no heap allocation at all,
+// which stats().heap_blocks makes easy to check.
+class MatrixArena {
+    public:
+    struct Stats {
+        std::size_t bytes_in_use = 0;     // bytes handed out and not yet rewound
+        std::size_t peak_bytes = 0;       // high-water mark of bytes_in_use
+        std::size_t allocations = 0;      // allocate() calls since reset_stats()
+        std::size_t heap_blocks = 0;      // blocks obtained from the heap, ever
+        std::size_t reserved_bytes = 0;   // total size of those blocks
+    };
+
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+        std::size_t bytes_in_use;
+    };
+
+    // The arena of the calling thread
+    static MatrixArena& local() {
+        thread_local MatrixArena arena;
+        return arena;
+    }
+
+    MatrixArena() { blocks.reserve(64); }
+    MatrixArena(const MatrixArena&) = delete;
+    MatrixArena& operator=(const MatrixArena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        ++statistics.allocations;
+        while (true) {
+            if (current < blocks.size()) {
+                Block& block = blocks[current];
+                const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+                const std::size_t start = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+                if (start + bytes <= block.size) {
+                    offset = start + bytes;
+                    statistics.bytes_in_use += bytes;
+                    if (statistics.bytes_in_use > statistics.peak_bytes) {
+                        statistics.peak_bytes = statistics.bytes_in_use;
+                    }
+                    return block.memory.get() + start;
+                }
+                if (current + 1 < blocks.size()) {
+                    ++current;
+                    offset = 0;
+                    continue;
+                }
+            }
+
+            // Out of blocks: grow geometrically, or exactly enough for an oversized request
+            std::size_t size = blocks.empty() ? initial_block_bytes : blocks.back().size * 2;
+            if (size < bytes + alignment) {
+                size = bytes + alignment;
+            }
+            blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+            ++statistics.heap_blocks;
+            statistics.reserved_bytes += size;
+            current = blocks.size() - 1;
+            offset = 0;
+        }
+    }
+
+    // Individual frees are ignored; memory comes back when a scope closes
+    void deallocate(void*, std::size_t) noexcept {}
+
+    Mark mark() const { return Mark{current, offset, statistics.bytes_in_use}; }
+
+    void release(const Mark& m) {
+        current = m.block;
+        offset = m.offset;
+        statistics.bytes_in_use = m.bytes_in_use;
+    }
+
+    const Stats& stats() const { return statistics; }
+
+    // Clears the per-workload counters; heap_blocks and reserved_bytes are kept
+    void reset_stats() {
+        statistics.peak_bytes = statistics.bytes_in_use;
+        statistics.allocations = 0;
+    }
+
+    private:
+    static constexpr std::size_t initial_block_bytes = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current = 0;
+    std::size_t offset = 0;
+    Stats statistics;
+};
+
+// Rewinds the thread's arena to its state at construction when destroyed.
+// Everything allocated from the arena inside the scope must be dead by then.
+class ArenaScope {
+    public:
+    ArenaScope() : arena(MatrixArena::local()), saved(arena.mark()) {}
+    ~ArenaScope() { arena.release(saved); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    private:
+    MatrixArena& arena;
+    MatrixArena::Mark saved;
+};
+
+// Standard allocator that draws from the calling thread's MatrixArena
+template <class T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(MatrixArena::local().allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        MatrixArena::local().deallocate(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "Matrix.h"
+#include "MatrixKernels.h"
+
+// Complex matrix in split storage: the real and imaginary parts are two
+// separate Matrix<R> planes. Matrix<std::complex<R>> is the interleaved
+// form; the split form feeds the real GEMM kernel with no repacking, so a
+// chain of products stays in this layout until the result is converted
+// back with interleaved().
+template <class R>
+class SplitComplexMatrix {
+    public:
+    SplitComplexMatrix(int rows, int columns) : re(rows, columns), im(rows, columns) {}
+
+    SplitComplexMatrix(const Matrix<R>& real_part, const Matrix<R>& imag_part)
+        : re(real_part), im(imag_part)
+    {
+        if (re.get_num_rows() != im.get_num_rows() || re.get_num_cols() != im.get_num_cols()) {
+            throw std::invalid_argument("Real and imaginary planes must have the same dimensions");
+        }
+    }
+
+    template <class Alloc>
+    explicit SplitComplexMatrix(const Matrix<std::complex<R>, Alloc>& m)
+        : re(m.get_num_rows(), m.get_num_cols()), im(m.get_num_rows(), m.get_num_cols())
+    {
+        const int count = m.get_num_rows() * m.get_num_cols();
+        for (int i = 0; i < count; ++i) {
+            re.data()[i] = m.data()[i].real();
+            im.data()[i] = m.data()[i].imag();
+        }
+    }
+
+    template <class Alloc = std::allocator<std::complex<R>>>
+    Matrix<std::complex<R>, Alloc> interleaved() const {
+        Matrix<std::complex<R>, Alloc> result(get_num_rows(), get_num_cols());
+        const int count = get_num_rows() * get_num_cols();
+        for (int i = 0; i < count; ++i) {
+            result.data()[i] = std::complex<R>(re.data()[i], im.data()[i]);
+        }
+        return result;
+    }
+
+    int get_num_rows() const { return re.get_num_rows(); }
+    int get_num_cols() const { return re.get_num_cols(); }
+
+    std::complex<R> get_element(int row, int column) const {
+        return std::complex<R>(re.get_element(row, column), im.get_element(row, column));
+    }
+
+    Matrix<R>& real() { return re; }
+    const Matrix<R>& real() const { return re; }
+    Matrix<R>& imag() { return im; }
+    const Matrix<R>& imag() const { return im; }
+
+    SplitComplexMatrix<R> conjugate_transpose() const {
+        return SplitComplexMatrix<R>(re.transpose(), -im.transpose());
+    }
+
+    // result = lhs * rhs; result must already have the right shape
+    static void multiply_into(const SplitComplexMatrix<R>& lhs, const SplitComplexMatrix<R>& rhs,
+                              SplitComplexMatrix<R>& result,
+                              matrix_kernels::ComplexKernel kernel = matrix_kernels::ComplexKernel::FourM)
+    {
+        const int m = lhs.get_num_rows(), k = lhs.get_num_cols(), n = rhs.get_num_cols();
+        if (k != rhs.get_num_rows()) {
+            throw std::invalid_argument("Matrices must have appropriate dimensions for multiplication");
+        }
+        if (result.get_num_rows() != m || result.get_num_cols() != n) {
+            throw std::invalid_argument("Result matrix has the wrong dimensions for multiplication");
+        }
+        if (&result == &lhs || &result == &rhs) {
+            throw std::invalid_argument("Result matrix must not alias an operand");
+        }
+
+        ArenaScope scope;
+        const std::size_t work_size = kernel == matrix_kernels::ComplexKernel::ThreeM
+            ? static_cast<std::size_t>(m) * k + static_cast<std::size_t>(k) * n + static_cast<std::size_t>(m) * n
+            : static_cast<std::size_t>(m) * n;
+        std::vector<R, ArenaAllocator<R>> work(work_size);
+
+        if (kernel == matrix_kernels::ComplexKernel::ThreeM) {
+            matrix_kernels::complex_gemm_3m(m, n, k, lhs.re.data(), lhs.im.data(), k,
+                                            rhs.re.data(), rhs.im.data(), n,
+                                            result.re.data(), result.im.data(), n, work.data());
+        } else {
+            matrix_kernels::complex_gemm_4m(m, n, k, lhs.re.data(), lhs.im.data(), k,
+                                            rhs.re.data(), rhs.im.data(), n,
+                                            result.re.data(), result.im.data(), n, work.data());
+        }
+    }
+
+    friend SplitComplexMatrix<R> operator*(const SplitComplexMatrix<R>& lhs, const SplitComplexMatrix<R>& rhs) {
+        SplitComplexMatrix<R> result(lhs.get_num_rows(), rhs.get_num_cols());
+        multiply_into(lhs, rhs, result);
+        return result;
+    }
+
+    private:
+    Matrix<R> re, im;
+};
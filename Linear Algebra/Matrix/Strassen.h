@@ -0,0 +1,202 @@
+#pragma once
+
+#include "MatrixKernels.h"
+
+#include <future>
+#include <vector>
+
+namespace matrix_kernels {
+
+struct StrassenOptions {
+    // Sub-problems of this edge length or smaller go to the classical kernel
+    int cutoff = 256;
+    // Recursion levels whose seven sub-products run concurrently
+    int parallel_depth = 1;
+};
+
+namespace strassen_detail {
+
+template <class T>
+void add(int n, const T* X, int ldx, const T* Y, int ldy, T* Z, int ldz) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            Z[i * ldz + j] = X[i * ldx + j] + Y[i * ldy + j];
+        }
+    }
+}
+
+template <class T>
+void sub(int n, const T* X, int ldx, const T* Y, int ldy, T* Z, int ldz) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            Z[i * ldz + j] = X[i * ldx + j] - Y[i * ldy + j];
+        }
+    }
+}
+
+template <class T>
+void winograd(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc,
+              const StrassenOptions& opt, int depth);
+
+// One Winograd step with the seven products computed concurrently.
+// Every operand and product gets its own buffer, so this variant trades
+// memory for parallelism and is only used near the top of the recursion.
+template <class T>
+void winograd_parallel(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc,
+                       const StrassenOptions& opt, int depth)
+{
+    const int h = n / 2;
+    const std::size_t quad = static_cast<std::size_t>(h) * h;
+    const T *A11 = A, *A12 = A + h, *A21 = A + h * lda, *A22 = A + h * lda + h;
+    const T *B11 = B, *B12 = B + h, *B21 = B + h * ldb, *B22 = B + h * ldb + h;
+    T *C11 = C, *C12 = C + h, *C21 = C + h * ldc, *C22 = C + h * ldc + h;
+
+    std::vector<T> buffer(15 * quad);
+    T* S1 = buffer.data();
+    T* S2 = S1 + quad;
+    T* S3 = S2 + quad;
+    T* S4 = S3 + quad;
+    T* T1 = S4 + quad;
+    T* T2 = T1 + quad;
+    T* T3 = T2 + quad;
+    T* T4 = T3 + quad;
+    T* P[7];
+    P[0] = T4 + quad;
+    for (int p = 1; p < 7; ++p) P[p] = P[p - 1] + quad;
+
+    add(h, A21, lda, A22, lda, S1, h);
+    sub(h, S1, h, A11, lda, S2, h);
+    sub(h, A11, lda, A21, lda, S3, h);
+    sub(h, A12, lda, S2, h, S4, h);
+    sub(h, B12, ldb, B11, ldb, T1, h);
+    sub(h, B22, ldb, T1, h, T2, h);
+    sub(h, B22, ldb, B12, ldb, T3, h);
+    sub(h, T2, h, B21, ldb, T4, h);
+
+    struct Product { const T* X; int ldx; const T* Y; int ldy; };
+    const Product products[7] = {
+        {A11, lda, B11, ldb},   // P1
+        {A12, lda, B21, ldb},   // P2
+        {S4, h, B22, ldb},      // P3
+        {A22, lda, T4, h},      // P4
+        {S1, h, T1, h},         // P5
+        {S2, h, T2, h},         // P6
+        {S3, h, T3, h},         // P7
+    };
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(6);
+    for (int p = 0; p < 6; ++p) {
+        pending.push_back(std::async(std::launch::async, [&, p] {
+            winograd(h, products[p].X, products[p].ldx, products[p].Y, products[p].ldy,
+                     P[p], h, opt, depth + 1);
+        }));
+    }
+    winograd(h, products[6].X, products[6].ldx, products[6].Y, products[6].ldy,
+             P[6], h, opt, depth + 1);
+    for (auto& f : pending) f.get();
+
+    for (int i = 0; i < h; ++i) {
+        for (int j = 0; j < h; ++j) {
+            const int k = i * h + j;
+            const T u2 = P[0][k] + P[5][k];
+            const T u3 = u2 + P[6][k];
+            C11[i * ldc + j] = P[0][k] + P[1][k];
+            C12[i * ldc + j] = u2 + P[4][k] + P[2][k];
+            C21[i * ldc + j] = u3 - P[3][k];
+            C22[i * ldc + j] = u3 + P[4][k];
+        }
+    }
+}
+
+// One Winograd step using only two h x h temporaries; the quadrants of C
+// double as scratch. Schedule from Boyer, Dumas, Pernet and Zhou,
+// "Memory efficient scheduling of Strassen-Winograd's matrix multiplication
+// algorithm" (2009), table 1.
+template <class T>
+void winograd_sequential(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc,
+                         const StrassenOptions& opt, int depth)
+{
+    const int h = n / 2;
+    const T *A11 = A, *A12 = A + h, *A21 = A + h * lda, *A22 = A + h * lda + h;
+    const T *B11 = B, *B12 = B + h, *B21 = B + h * ldb, *B22 = B + h * ldb + h;
+    T *C11 = C, *C12 = C + h, *C21 = C + h * ldc, *C22 = C + h * ldc + h;
+
+    std::vector<T> buffer(2 * static_cast<std::size_t>(h) * h);
+    T* X = buffer.data();
+    T* Y = X + static_cast<std::size_t>(h) * h;
+
+    sub(h, A11, lda, A21, lda, X, h);                       // S3
+    sub(h, B22, ldb, B12, ldb, Y, h);                       // T3
+    winograd(h, X, h, Y, h, C21, ldc, opt, depth + 1);      // P7
+    add(h, A21, lda, A22, lda, X, h);                       // S1
+    sub(h, B12, ldb, B11, ldb, Y, h);                       // T1
+    winograd(h, X, h, Y, h, C22, ldc, opt, depth + 1);      // P5
+    sub(h, X, h, A11, lda, X, h);                           // S2
+    sub(h, B22, ldb, Y, h, Y, h);                           // T2
+    winograd(h, X, h, Y, h, C12, ldc, opt, depth + 1);      // P6
+    sub(h, A12, lda, X, h, X, h);                           // S4
+    winograd(h, X, h, B22, ldb, C11, ldc, opt, depth + 1);  // P3
+    winograd(h, A11, lda, B11, ldb, X, h, opt, depth + 1);  // P1
+    add(h, X, h, C12, ldc, C12, ldc);                       // U2 = P1 + P6
+    add(h, C12, ldc, C21, ldc, C21, ldc);                   // U3 = U2 + P7
+    add(h, C12, ldc, C22, ldc, C12, ldc);                   // U4 = U2 + P5
+    add(h, C21, ldc, C22, ldc, C22, ldc);                   // U7 = U3 + P5
+    add(h, C12, ldc, C11, ldc, C12, ldc);                   // U5 = U4 + P3
+    sub(h, Y, h, B21, ldb, Y, h);                           // T4
+    winograd(h, A22, lda, Y, h, C11, ldc, opt, depth + 1);  // P4
+    sub(h, C21, ldc, C11, ldc, C21, ldc);                   // U6 = U3 - P4
+    winograd(h, A12, lda, B21, ldb, C11, ldc, opt, depth + 1); // P2
+    add(h, X, h, C11, ldc, C11, ldc);                       // U1 = P1 + P2
+}
+
+template <class T>
+void winograd(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc,
+              const StrassenOptions& opt, int depth)
+{
+    if (n <= opt.cutoff || n % 2 != 0) {
+        gemm(n, n, n, A, lda, B, ldb, C, ldc);
+    } else if (depth < opt.parallel_depth) {
+        winograd_parallel(n, A, lda, B, ldb, C, ldc, opt, depth);
+    } else {
+        winograd_sequential(n, A, lda, B, ldb, C, ldc, opt, depth);
+    }
+}
+
+}
+
+// C (n x n) = A (n x n) * B (n x n) by Strassen-Winograd recursion.
+// The operands are zero-padded so that every level halves evenly down to
+// the cutoff; padding is skipped when n already divides.
+template <class T>
+void strassen_gemm(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc,
+                   const StrassenOptions& opt = {})
+{
+    const int cutoff = std::max(opt.cutoff, 1);
+    int levels = 0;
+    int leaf = n;
+    while (leaf > cutoff) {
+        leaf = (leaf + 1) / 2;
+        ++levels;
+    }
+    const int padded = leaf << levels;
+
+    if (padded == n) {
+        strassen_detail::winograd(n, A, lda, B, ldb, C, ldc, opt, 0);
+        return;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(padded) * padded;
+    std::vector<T> Ap(size, T(0)), Bp(size, T(0)), Cp(size);
+    for (int i = 0; i < n; ++i) {
+        std::copy(A + i * lda, A + i * lda + n, Ap.data() + static_cast<std::size_t>(i) * padded);
+        std::copy(B + i * ldb, B + i * ldb + n, Bp.data() + static_cast<std::size_t>(i) * padded);
+    }
+    strassen_detail::winograd(padded, Ap.data(), padded, Bp.data(), padded, Cp.data(), padded, opt, 0);
+    for (int i = 0; i < n; ++i) {
+        std::copy(Cp.data() + static_cast<std::size_t>(i) * padded,
+                  Cp.data() + static_cast<std::size_t>(i) * padded + n, C + i * ldc);
+    }
+}
+
+}
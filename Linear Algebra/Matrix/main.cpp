@@ -1,5 +1,14 @@
 #include "Matrix.h"
+#include "MappedMatrix.h"
+#include "SplitComplexMatrix.h"
+#include "../../Appendix/Binary IO/binary_io.h"
+#include "../../Appendix/Instrumentation/instrumentation.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <utility>
 #include <vector>
 #include <cassert>
 #include <cmath>
@@ -142,6 +151,434 @@ int main() {
     assert(hadamard.get_element(0, 0) == 1.0 && hadamard.get_element(1, 1) == 16.0);
     std::cout << "Hadamard product passed\n\n";
 
+    // Test 18: Higher Matrix Power
+    std::cout << "Test 18: Higher Matrix Power\n";
+    auto pow7 = m3.power(7);
+    auto expected_pow7 = m3 * m3 * m3 * m3 * m3 * m3 * m3;
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            assert(std::abs(pow7.get_element(i, j) - expected_pow7.get_element(i, j)) < 1e-6);
+        }
+    }
+    assert(m3.power(0) == Matrix<double>::identity_matrix(2));
+    std::cout << "Higher matrix power passed\n\n";
+
+    // Test 19: Matrix Exponential
+    std::cout << "Test 19: Matrix Exponential\n";
+    // exp(t [[0, 1], [-1, 0]]) is a rotation by t
+    for (double t : {1e-3, 0.5, 2.0, 10.0}) {
+        double rot_data[] = {0.0, t, -t, 0.0};
+        auto rot = Matrix<double>(2, 2, rot_data).expm();
+        assert(std::abs(rot.get_element(0, 0) - std::cos(t)) < 1e-12);
+        assert(std::abs(rot.get_element(0, 1) - std::sin(t)) < 1e-12);
+        assert(std::abs(rot.get_element(1, 0) + std::sin(t)) < 1e-12);
+        assert(std::abs(rot.get_element(1, 1) - std::cos(t)) < 1e-12);
+    }
+    // exp(diag(d)) = diag(exp(d))
+    auto exp_diag = Matrix<double>::diagonal_matrix({-1.0, 0.0, 3.0}).expm();
+    assert(std::abs(exp_diag.get_element(0, 0) - std::exp(-1.0)) < 1e-12);
+    assert(std::abs(exp_diag.get_element(1, 1) - 1.0) < 1e-12);
+    assert(std::abs(exp_diag.get_element(2, 2) - std::exp(3.0)) < 1e-10);
+    assert(exp_diag.get_element(0, 2) == 0.0);
+    // Single precision selects degree and scaling from its own θ table
+    for (float t : {0.1f, 2.0f, 10.0f}) {
+        float rot_data[] = {0.0f, t, -t, 0.0f};
+        auto rot = Matrix<float>(2, 2, rot_data).expm();
+        assert(std::abs(rot.get_element(0, 0) - std::cos(t)) < 1e-5f);
+        assert(std::abs(rot.get_element(0, 1) - std::sin(t)) < 1e-5f);
+    }
+    std::cout << "Matrix exponential passed\n\n";
+
+    // Test 20: Strassen-Winograd Multiplication
+    std::cout << "Test 20: Strassen-Winograd Multiplication\n";
+    for (int n : {64, 150}) {
+        Matrix<double> A(n, n), B(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                A(i, j) = std::sin(i + 2.0 * j);
+                B(i, j) = std::cos(3.0 * i - j);
+            }
+        }
+        matrix_kernels::StrassenOptions options;
+        options.cutoff = 16;
+        auto fast = Matrix<double>::strassen_multiply(A, B, options);
+        auto classical = A * B;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                assert(std::abs(fast(i, j) - classical(i, j)) < 1e-10);
+            }
+        }
+    }
+    std::cout << "Strassen-Winograd multiplication passed\n\n";
+
+    // Test 21: Memory-Mapped Tiled Matrices
+    std::cout << "Test 21: Memory-Mapped Tiled Matrices\n";
+    {
+        const auto dir = std::filesystem::temp_directory_path();
+        const std::string a_path = (dir / "matrix_test_a.bin").string();
+        const std::string b_path = (dir / "matrix_test_b.bin").string();
+        const std::string c_path = (dir / "matrix_test_c.bin").string();
+
+        // 37 x 37 with 16 x 16 tiles exercises the padded edge tiles
+        const int n = 37;
+        Matrix<double> A(n, n), B(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                A(i, j) = std::sin(i + 0.5 * j);
+                B(i, j) = std::cos(i - 2.0 * j);
+            }
+        }
+
+        {
+            auto mA = MappedMatrix<double>::from_matrix(a_path, A, 16);
+            auto mB = MappedMatrix<double>::from_matrix(b_path, B, 16);
+            auto mC = MappedMatrix<double>::create(c_path, n, n, 16);
+            tiled_multiply(mA, mB, mC);
+            mC.flush();
+        }
+        auto product = MappedMatrix<double>::open(c_path).to_matrix();
+        auto expected = A * B;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                assert(std::abs(product(i, j) - expected(i, j)) < 1e-12);
+            }
+        }
+
+        auto mA = MappedMatrix<double>::open(a_path);
+        auto mAt = MappedMatrix<double>::create(b_path, n, n, 16);
+        tiled_transpose(mA, mAt);
+        assert(mAt.to_matrix() == A.transpose());
+
+        // A A^T + n I is symmetric positive definite
+        auto spd = A * A.transpose() + static_cast<double>(n) * Matrix<double>::identity_matrix(n);
+        auto mS = MappedMatrix<double>::from_matrix(c_path, spd, 16);
+        tiled_cholesky(mS);
+        auto Ls = mS.to_matrix();
+        auto LLt_tiled = Ls * Ls.transpose();
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                assert(std::abs(LLt_tiled(i, j) - spd(i, j)) < 1e-9);
+                if (j > i) assert(Ls(i, j) == 0.0);
+            }
+        }
+
+        // Corrupt headers are rejected instead of narrowed or divided by
+        const std::string d_path = (dir / "matrix_test_d.bin").string();
+        const std::pair<std::size_t, std::int64_t> corruptions[] = {
+            {offsetof(MappedMatrixHeader, tile), 0},
+            {offsetof(MappedMatrixHeader, tile), std::numeric_limits<int>::max()},
+            {offsetof(MappedMatrixHeader, rows), -1},
+            {offsetof(MappedMatrixHeader, columns), std::int64_t{1} << 40},
+            {offsetof(MappedMatrixHeader, data_offset), 0},
+        };
+        for (const auto& [field, value] : corruptions) {
+            MappedMatrix<double>::from_matrix(d_path, A, 16);
+            {
+                std::fstream patch(d_path, std::ios::in | std::ios::out | std::ios::binary);
+                patch.seekp(static_cast<std::streamoff>(field));
+                patch.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+            bool bad_header_rejected = false;
+            try {
+                MappedMatrix<double>::open(d_path);
+            } catch (const std::runtime_error&) {
+                bad_header_rejected = true;
+            }
+            assert(bad_header_rejected);
+        }
+
+        std::filesystem::remove(a_path);
+        std::filesystem::remove(b_path);
+        std::filesystem::remove(c_path);
+        std::filesystem::remove(d_path);
+    }
+    std::cout << "Memory-mapped tiled matrices passed\n\n";
+
+    // Test 22: Binary Serialization
+    std::cout << "Test 22: Binary Serialization\n";
+    {
+        namespace bio = appendix::binary_io;
+        const auto dir = std::filesystem::temp_directory_path();
+        const std::string m_path = (dir / "matrix_test_dense.ncbf").string();
+        const std::string v_path = (dir / "matrix_test_vector.ncbf").string();
+        const std::string s_path = (dir / "matrix_test_csr.ncbf").string();
+
+        Matrix<double> M(3, 4);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                M(i, j) = 0.25 * i - j;
+            }
+        }
+        bio::save(m_path, M);
+        assert(bio::load_matrix<double>(m_path) == M);
+        auto view = bio::map_matrix<double>(m_path);
+        assert(view.rows() == 3 && view.cols() == 4 && view(2, 3) == M(2, 3));
+        assert(view.to_matrix() == M);
+
+        std::vector<float> v = {1.0f, -2.5f, 3.25f};
+        bio::save(v_path, v);
+        assert(bio::load_vector<float>(v_path) == v);
+        assert(bio::map_vector<float>(v_path)[2] == 3.25f);
+
+        // [[1, 0, 2], [0, 0, 3]]
+        bio::CsrMatrix<double> S;
+        S.rows = 2;
+        S.cols = 3;
+        S.row_ptr = {0, 2, 3};
+        S.col_idx = {0, 2, 2};
+        S.values = {1.0, 2.0, 3.0};
+        bio::save(s_path, S);
+        auto S_loaded = bio::load_csr<double>(s_path);
+        assert(S_loaded.row_ptr == S.row_ptr && S_loaded.col_idx == S.col_idx && S_loaded.values == S.values);
+        auto S_view = bio::map_csr<double>(s_path);
+        assert(S_view.nnz() == 3 && S_view.col_idx()[1] == 2 && S_view.values()[2] == 3.0);
+
+        // A header whose nnz disagrees with the payload is never mapped
+        for (std::int64_t bad_nnz : {std::int64_t{1} << 40, std::int64_t{-1}}) {
+            bio::save(s_path, S);
+            {
+                std::fstream patch(s_path, std::ios::in | std::ios::out | std::ios::binary);
+                patch.seekp(offsetof(bio::FileHeader, nnz));
+                patch.write(reinterpret_cast<const char*>(&bad_nnz), sizeof(bad_nnz));
+            }
+            bool bad_header_rejected = false;
+            try {
+                bio::map_csr<double>(s_path);
+            } catch (const std::runtime_error&) {
+                bad_header_rejected = true;
+            }
+            assert(bad_header_rejected);
+        }
+
+        // Likewise dense shapes: negative, beyond int, a rows * cols * 8
+        // that wraps round to the real payload size, and a two-column vector
+        struct DenseCorruption {
+            bool vector;
+            std::size_t field;
+            std::int64_t value;
+        };
+        const DenseCorruption dense_corruptions[] = {
+            {false, offsetof(bio::FileHeader, rows), -1},
+            {false, offsetof(bio::FileHeader, cols), std::int64_t{1} << 40},
+            {false, offsetof(bio::FileHeader, rows), (std::int64_t{1} << 61) + 3},
+            {true, offsetof(bio::FileHeader, rows), -1},
+            {true, offsetof(bio::FileHeader, cols), 2},
+        };
+        for (const auto& c : dense_corruptions) {
+            const std::string& path = c.vector ? v_path : m_path;
+            if (c.vector) bio::save(v_path, v);
+            else bio::save(m_path, M);
+            {
+                std::fstream patch(path, std::ios::in | std::ios::out | std::ios::binary);
+                patch.seekp(static_cast<std::streamoff>(c.field));
+                patch.write(reinterpret_cast<const char*>(&c.value), sizeof(c.value));
+            }
+            int rejected = 0;
+            try {
+                if (c.vector) bio::load_vector<float>(path);
+                else bio::load_matrix<double>(path);
+            } catch (const std::runtime_error&) {
+                ++rejected;
+            }
+            try {
+                if (c.vector) bio::map_vector<float>(path);
+                else bio::map_matrix<double>(path);
+            } catch (const std::runtime_error&) {
+                ++rejected;
+            }
+            assert(rejected == 2);
+        }
+        bio::save(m_path, M);
+
+        bool wrong_type_rejected = false;
+        try {
+            bio::load_matrix<float>(m_path);
+        } catch (const std::runtime_error&) {
+            wrong_type_rejected = true;
+        }
+        assert(wrong_type_rejected);
+
+#ifdef NUMERIC_WITH_ZLIB
+        bio::save(m_path, M, bio::Compression::Zlib);
+        assert(bio::load_matrix<double>(m_path) == M);
+        bio::save(s_path, S, bio::Compression::Zlib);
+        assert(bio::load_csr<double>(s_path).values == S.values);
+#endif
+
+        std::filesystem::remove(m_path);
+        std::filesystem::remove(v_path);
+        std::filesystem::remove(s_path);
+    }
+    std::cout << "Binary serialization passed\n\n";
+
+    // Test 23: Scratch Arena
+    std::cout << "Test 23: Scratch Arena\n";
+    {
+        Matrix<double> M(5, 5);
+        for (int i = 0; i < 5; ++i) {
+            for (int j = 0; j < 5; ++j) {
+                M(i, j) = (i == j) ? 10.0 : 1.0 / (1.0 + i + j);
+            }
+        }
+
+        // Warm up once so the arena owns enough blocks, then check that
+        // repeated calls neither grow it nor leave anything behind
+        auto& arena = MatrixArena::local();
+        M.determinant();
+        M.inverse();
+        M.eigenvalues();
+        M.expm();
+        const auto blocks_after_warmup = arena.stats().heap_blocks;
+        arena.reset_stats();
+
+        double det = 0.0;
+        for (int iter = 0; iter < 50; ++iter) {
+            det = M.determinant();
+            M.inverse();
+            M.eigenvalues();
+            M.expm();
+        }
+        assert(arena.stats().heap_blocks == blocks_after_warmup);
+        assert(arena.stats().bytes_in_use == 0);
+        assert(arena.stats().allocations > 0 && arena.stats().peak_bytes > 0);
+        assert(std::abs(det - M.determinant()) < 1e-12);
+
+        // Arena-backed matrices are usable directly inside a scope
+        {
+            ArenaScope scope;
+            Matrix<double, ArenaAllocator<double>> S(2, 2, data);
+            auto S2 = S * S;
+            assert(S2.get_element(1, 1) == 22.0);
+            assert(arena.stats().bytes_in_use > 0);
+        }
+        assert(arena.stats().bytes_in_use == 0);
+    }
+    std::cout << "Scratch arena passed\n\n";
+
+    // Test 24: Complex Matrices
+    std::cout << "Test 24: Complex Matrices\n";
+    {
+        using C = std::complex<double>;
+        const C I(0.0, 1.0);
+
+        // Products: interleaved 4M and 3M kernels and split storage agree
+        // with a plain triple loop
+        const int n = 23;
+        Matrix<C> X(n, n), Y(n, n), XY(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                X(i, j) = C(std::sin(i + 2.0 * j), std::cos(3.0 * i - j));
+                Y(i, j) = C(1.0 / (1.0 + i + j), 0.1 * (i - j));
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                for (int k = 0; k < n; ++k) {
+                    XY(i, j) += X(i, k) * Y(k, j);
+                }
+            }
+        }
+        Matrix<C> P4 = X * Y;
+        Matrix<C> P3(n, n);
+        Matrix<C>::multiply_into(X, Y, P3, matrix_kernels::ComplexKernel::ThreeM);
+        SplitComplexMatrix<double> Xs(X), Ys(Y);
+        SplitComplexMatrix<double> Ps(n, n);
+        SplitComplexMatrix<double>::multiply_into(Xs, Ys, Ps, matrix_kernels::ComplexKernel::ThreeM);
+        Matrix<C> Pi = Ps.interleaved();
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                assert(std::abs(P4(i, j) - XY(i, j)) < 1e-12);
+                assert(std::abs(P3(i, j) - XY(i, j)) < 1e-12);
+                assert(std::abs(Pi(i, j) - XY(i, j)) < 1e-12);
+            }
+        }
+
+        // Conjugate transpose, in both layouts
+        Matrix<C> Xh = X.conjugate_transpose();
+        SplitComplexMatrix<double> Xsh = Xs.conjugate_transpose();
+        assert(Xh(3, 5) == std::conj(X(5, 3)));
+        assert(Xsh.get_element(3, 5) == Xh(3, 5));
+
+        // Hermitian positive definite H = [[4, 1+i], [1-i, 3]], eigenvalues 2 and 5
+        C h_data[] = {4.0, 1.0 + I, 1.0 - I, 3.0};
+        Matrix<C> H(2, 2, h_data);
+        std::vector<double> lambda = H.hermitian_eigenvalues();
+        assert(std::abs(lambda[0] - 2.0) < 1e-12 && std::abs(lambda[1] - 5.0) < 1e-12);
+
+        Matrix<C> L = H.CholeskyDecomposition();
+        Matrix<C> LLh = L * L.conjugate_transpose();
+        assert(L(0, 1) == C(0.0) && L(1, 1).imag() == 0.0);
+        for (int i = 0; i < 4; ++i) {
+            assert(std::abs(LLh.data()[i] - h_data[i]) < 1e-12);
+        }
+
+        // Real symmetric matrices take the same path without the embedding
+        double s_data[] = {2.0, -1.0, 0.0, -1.0, 2.0, -1.0, 0.0, -1.0, 2.0};
+        std::vector<double> s_lambda = Matrix<double>(3, 3, s_data).hermitian_eigenvalues();
+        assert(std::abs(s_lambda[0] - (2.0 - std::sqrt(2.0))) < 1e-12);
+        assert(std::abs(s_lambda[1] - 2.0) < 1e-12);
+        assert(std::abs(s_lambda[2] - (2.0 + std::sqrt(2.0))) < 1e-12);
+
+        // Complex QR: Q is unitary and Q R reproduces the matrix
+        Matrix<C> Q, R;
+        X.QRDecomposition(Q, R);
+        Matrix<C> QhQ = Q.conjugate_transpose() * Q;
+        Matrix<C> QR = Q * R;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                assert(std::abs(QhQ(i, j) - (i == j ? C(1.0) : C(0.0))) < 1e-12);
+                assert(std::abs(QR(i, j) - X(i, j)) < 1e-12);
+            }
+        }
+
+        // Inverse of a complex matrix
+        Matrix<C> Hinv = H.inverse();
+        Matrix<C> HHinv = H * Hinv;
+        assert(std::abs(HHinv(0, 0) - C(1.0)) < 1e-12 && std::abs(HHinv(0, 1)) < 1e-12);
+    }
+    std::cout << "Complex matrices passed\n\n";
+
+    // Test 25: Instrumentation
+    std::cout << "Test 25: Instrumentation\n";
+    {
+        namespace instr = appendix::instrumentation;
+        instr::reset();
+
+        Matrix<double> A(40, 30), B(30, 20), AB(40, 20);
+        Matrix<double>::multiply_into(A, B, AB);
+        Matrix<double>::multiply_into(A, B, AB);
+        A.transpose();
+
+        const std::string json = instr::to_json();
+#ifdef NUMERIC_INSTRUMENT
+        {
+            bool found = false;
+            for (const auto& [name, totals] : instr::totals()) {
+                if (name == "matrix.multiply") {
+                    found = true;
+                    assert(totals.calls == 2);
+                    assert(totals.flops == 2ull * 2 * 40 * 30 * 20);
+                    assert(totals.bytes == 2ull * sizeof(double) * (40 * 30 + 30 * 20 + 40 * 20));
+                }
+            }
+            assert(found);
+            assert(json.find("\"matrix.transpose\"") != std::string::npos);
+            std::cout << json << "\n";
+
+            // Counting restarts from the reset; other threads' counters are
+            // not written, only baselined
+            instr::reset();
+            assert(instr::totals().empty());
+            Matrix<double>::multiply_into(A, B, AB);
+            const auto after = instr::totals();
+            assert(after.size() == 1 && after[0].first == "matrix.multiply" && after[0].second.calls == 1);
+        }
+#else
+        assert(json == "{\"enabled\": false}");
+#endif
+    }
+    std::cout << "Instrumentation passed\n\n";
+
     std::cout << "All tests passed successfully!\n";
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Matrix.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+// Times the classical blocked kernel against Strassen-Winograd for a range
+// of sizes and cutoffs, reports the relative error of the fast product, and
+// prints the smallest size at which Strassen-Winograd wins on this host.
+// With NUMERIC_OPENMP the OpenMP team of the main thread is pinned to one
+// thread, so the classical kernel and the serial Strassen-Winograd column
+// (parallel_depth = 0) both run serially and the crossover is taken from
+// the latter. The parallel column (seven concurrent sub-products at the top
+// level) is reported separately; its std::async workers keep the default
+// team size, so with OpenMP their leaf products oversubscribe the cores.
+//
+// Usage: strassen_benchmark [max_size]      (default 4096)
+
+namespace {
+
+template <class F>
+double seconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+Matrix<double> random_matrix(int n, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix<double> M(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            M(i, j) = dist(gen);
+        }
+    }
+    return M;
+}
+
+// max |C_fast - C_ref| / max |C_ref|
+double relative_error(const Matrix<double>& fast, const Matrix<double>& ref) {
+    double err = 0.0, scale = 0.0;
+    for (int i = 0; i < ref.get_num_rows(); ++i) {
+        for (int j = 0; j < ref.get_num_cols(); ++j) {
+            err = std::max(err, std::abs(fast(i, j) - ref(i, j)));
+            scale = std::max(scale, std::abs(ref(i, j)));
+        }
+    }
+    return err / scale;
+}
+
+}
+
+int main(int argc, char** argv) {
+#if defined(_OPENMP)
+    omp_set_num_threads(1);
+#endif
+    const int max_size = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const int cutoffs[] = {64, 128, 256, 512};
+
+    std::mt19937 gen(42);
+    int crossover = -1;
+
+    std::cout << std::setw(6) << "n" << std::setw(14) << "classical[s]"
+              << std::setw(8) << "cutoff" << std::setw(14) << "serial[s]" << std::setw(10) << "speedup"
+              << std::setw(14) << "parallel[s]" << std::setw(10) << "speedup"
+              << std::setw(14) << "rel. error" << "\n";
+
+    for (int n = 256; n <= max_size; n *= 2) {
+        Matrix<double> A = random_matrix(n, gen);
+        Matrix<double> B = random_matrix(n, gen);
+        Matrix<double> reference(n, n);
+
+        double t_classical = seconds([&] { Matrix<double>::multiply_into(A, B, reference); });
+
+        double best = t_classical;
+        for (int cutoff : cutoffs) {
+            if (cutoff >= n) continue;
+
+            matrix_kernels::StrassenOptions options;
+            options.cutoff = cutoff;
+            options.parallel_depth = 0;
+            Matrix<double> fast;
+            double t_fast = seconds([&] { fast = Matrix<double>::strassen_multiply(A, B, options); });
+            best = std::min(best, t_fast);
+
+            options.parallel_depth = 1;
+            Matrix<double> threaded;
+            double t_threaded = seconds([&] { threaded = Matrix<double>::strassen_multiply(A, B, options); });
+
+            std::cout << std::setw(6) << n << std::setw(14) << std::fixed << std::setprecision(4) << t_classical
+                      << std::setw(8) << cutoff << std::setw(14) << t_fast
+                      << std::setw(10) << std::setprecision(2) << t_classical / t_fast
+                      << std::setw(14) << std::setprecision(4) << t_threaded
+                      << std::setw(10) << std::setprecision(2) << t_classical / t_threaded
+                      << std::setw(14) << std::scientific << std::setprecision(2)
+                      << relative_error(fast, reference) << "\n";
+        }
+
+        if (crossover < 0 && best < t_classical) {
+            crossover = n;
+        }
+    }
+
+    if (crossover > 0) {
+        std::cout << "\nSerial Strassen-Winograd first beats the classical kernel at n = " << crossover << "\n";
+    } else {
+        std::cout << "\nSerial Strassen-Winograd did not beat the classical kernel up to n = " << max_size << "\n";
+    }
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "Vector2D.h"
 #include "Utils.h"
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <numbers>
@@ -328,19 +329,19 @@ Vector2D<T> Vector2D<T>::normalized_or_zero() const noexcept
 template<arithmetic T>
 Vector2D<T> Vector2D<T>::floor() const noexcept
 {
-    return { std::floor(x), std::floor(y) };
+    return { static_cast<T>(std::floor(x)), static_cast<T>(std::floor(y)) };
 }
 
 template<arithmetic T>
 Vector2D<T> Vector2D<T>::ceil() const noexcept
 {
-    return { std::ceil(x), std::ceil(y) };
+    return { static_cast<T>(std::ceil(x)), static_cast<T>(std::ceil(y)) };
 }
 
 template<arithmetic T>
 Vector2D<T> Vector2D<T>::round() const noexcept
 {
-    return { std::round(x), std::round(y) };
+    return { static_cast<T>(std::round(x)), static_cast<T>(std::round(y)) };
 }
 
 
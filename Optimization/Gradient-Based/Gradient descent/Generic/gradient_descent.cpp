@@ -1,5 +1,3 @@
-#pragma once
-
 #include "gradient_descent.h"
 
 #include <cmath>
@@ -66,3 +64,6 @@ void gradient_descent(F objective,
 
     std::cout << "maximum iterations reached.\n";
 }
+
+template void gradient_descent<float, expression<float>*>(expression<float>*, std::vector<variable<float>*>&, float, int, float);
+template void gradient_descent<double, expression<double>*>(expression<double>*, std::vector<variable<double>*>&, double, int, double);
@@ -1,6 +1,9 @@
 #pragma once
 
-#include "../Analysis/Differentiation/AutoDiff/autodiff.h"
+#include "../../../../Differentiation/AutoDiff/autodiff.h"
+#include "../../../../Differentiation/AutoDiff/reverse_mode.h"
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <iostream>
 
@@ -22,4 +25,54 @@ inline void gradient_descent(F objective,
                            learning_rate,
                            MaxIterations,
                            tolerance);
-}
\ No newline at end of file
+}
+
+// Reverse-mode variant: objective is any callable taking
+// const std::vector<autodiff::reverse_var<T>>& and returning
+// autodiff::reverse_var<T>, e.g. a lambda written with ordinary operators.
+// Each iteration records the objective once on a tape and gets the whole
+// gradient from one backward sweep, instead of one graph evaluation per
+// variable. x holds the starting point and receives the result.
+template<typename T, typename F>
+void gradient_descent(F objective,
+                      std::vector<T>& x,
+                      T learning_rate,
+                      int max_iterations,
+                      T tolerance)
+{
+    if (x.empty()) {
+        std::cerr << "gradient_descent: no variables to optimize\n";
+        return;
+    }
+    if (max_iterations <= 0) {
+        std::cerr << "gradient_descent: max_iterations must be positive\n";
+        return;
+    }
+
+    autodiff::tape<T> tape;
+    std::vector<T> gradients(x.size());
+    T prev_value = std::numeric_limits<T>::infinity();
+
+    for (int iter = 0; iter < max_iterations; ++iter)
+    {
+        const T current_value = autodiff::value_and_gradient(objective, x, gradients, tape);
+
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            x[i] -= learning_rate * gradients[i];
+        }
+
+        std::cout << "iteration " << (iter + 1) << ":\tvalue = " << current_value;
+        for (std::size_t i = 0; i < x.size(); ++i)
+            std::cout << ", x_" << i << " = " << x[i];
+        std::cout << '\n';
+
+        if (std::fabs(current_value - prev_value) < tolerance) {
+            std::cout << "converged within tolerance.\n";
+            return;
+        }
+
+        prev_value = current_value;
+    }
+
+    std::cout << "maximum iterations reached.\n";
+}
@@ -1,7 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
-#include "..\..\..\CSV Reader\csv.h"
+#include "../../../../Appendix/CSV Reader/csv.h"
 
 // Function to calculate the mean of a vector
 double mean(std::vector<double> v) {
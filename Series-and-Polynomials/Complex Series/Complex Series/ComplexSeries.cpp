@@ -1,4 +1,4 @@
-#include "ComplexSeries.hpp"
+#include "ComplexSeries.h"
 #include <cmath>
 #include <sstream>
 #include <fmt/core.h>
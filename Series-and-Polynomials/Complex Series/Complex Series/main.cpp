@@ -1,4 +1,4 @@
-#include "ComplexSeries.hpp"
+#include "ComplexSeries.h"
 #include <iostream>
 #include <complex>
 
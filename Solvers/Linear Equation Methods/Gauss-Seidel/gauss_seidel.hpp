@@ -7,6 +7,9 @@
 #include <stdexcept>
 #include <vector>
 
+#include "../../../Appendix/Instrumentation/instrumentation.h"
+#include "../utils.hpp"
+
 namespace linear_solver {
 
 [[nodiscard]] inline std::vector<double>
@@ -20,6 +23,7 @@ gauss_seidel(const std::vector<std::vector<double>>& A,
     if (n == 0 || n != A[0].size() || n != b.size() || n != x0.size()) {
         throw std::invalid_argument("Matrix and vector dimensions must match.");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "linear_solver.gauss_seidel", 0, 0);
 
     auto x = x0;
     auto x_new = x0;
@@ -48,7 +52,8 @@ gauss_seidel(const std::vector<std::vector<double>>& A,
             max_error = std::max(max_error, std::abs(x_new[i] - x[i]));
         }
 
-        x = std::move(x_new);
+        NUMERIC_INSTRUMENT_ADD(probe, 2 * n * n, sizeof(double) * (n * n + 3 * n));
+        x = x_new;
 
         if (max_error < tol) {
             std::cout << "Gauss-Seidel converged after " << iter + 1 << " iterations.\n";
@@ -60,12 +65,4 @@ gauss_seidel(const std::vector<std::vector<double>>& A,
                              std::to_string(max_iter) + " iterations.");
 }
 
-inline void print_solution(const std::vector<double>& x)
-{
-    std::cout << std::fixed << std::setprecision(10);
-    for (std::size_t i = 0; i < x.size(); ++i) {
-        std::cout << "x" << i + 1 << " = " << x[i] << '\n';
-    }
-}
-
 } 
\ No newline at end of file
@@ -7,6 +7,9 @@
 #include <stdexcept>
 #include <vector>
 
+#include "../../../Appendix/Instrumentation/instrumentation.h"
+#include "../utils.hpp"
+
 namespace linear_solver {
 
 inline std::vector<double> jacobi(
@@ -20,6 +23,7 @@ inline std::vector<double> jacobi(
     if (n == 0 || n != A[0].size() || n != b.size() || n != x0.size()) {
         throw std::invalid_argument("Matrix and vector dimensions must match.");
     }
+    NUMERIC_INSTRUMENT_SCOPE(probe, "linear_solver.jacobi", 0, 0);
 
     auto x = x0;
     auto x_new = std::vector<double>(n, 0.0);
@@ -43,6 +47,7 @@ inline std::vector<double> jacobi(
             max_error = std::max(max_error, std::abs(x_new[i] - x[i]));
         }
 
+        NUMERIC_INSTRUMENT_ADD(probe, 2 * n * n, sizeof(double) * (n * n + 3 * n));
         x = x_new;
 
         if (max_error < tol) {
@@ -54,12 +59,4 @@ inline std::vector<double> jacobi(
     throw std::runtime_error("Jacobi did not converge within " + std::to_string(max_iter) + " iterations.");
 }
 
-inline void print_solution(const std::vector<double>& x)
-{
-    std::cout << std::fixed << std::setprecision(10);
-    for (std::size_t i = 0; i < x.size(); ++i) {
-        std::cout << "x" << i + 1 << " = " << x[i] << '\n';
-    }
-}
-
 } 
\ No newline at end of file
@@ -1,7 +1,11 @@
+#include "SOR.hpp"
+
 #include <vector>
 #include <cmath>
 #include <stdexcept>
 
+#include "../../../Appendix/Instrumentation/instrumentation.h"
+
 /*
     Perform one or more iterations of the SOR method to solve A x = b.
 
@@ -33,8 +37,8 @@ void SOR(
     const std::vector<double>& b,
     std::vector<double>& x,
     double omega,
-    int maxIter = 5000,
-    double tol = 1e-10
+    int maxIter,
+    double tol
 ) {
     int n = A.size();
     if (n == 0 || A[0].size() != n)
@@ -46,6 +50,8 @@ void SOR(
     if (omega <= 0.0 || omega >= 2.0)
         throw std::invalid_argument("Relaxation parameter ω must satisfy 0 < ω < 2.");
 
+    NUMERIC_INSTRUMENT_SCOPE(probe, "linear_solver.sor", 0, 0);
+
     std::vector<double> x_old(n);
 
     for (int iter = 0; iter < maxIter; ++iter) {
@@ -82,6 +88,8 @@ void SOR(
             resid += s * s;
         }
         resid = std::sqrt(resid);
+        // SOR sweep plus residual: two passes over A
+        NUMERIC_INSTRUMENT_ADD(probe, 4.0 * n * n, sizeof(double) * (2.0 * n * n + 4.0 * n));
 
         if (resid < tol)
             return;
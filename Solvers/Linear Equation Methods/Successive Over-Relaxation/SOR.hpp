@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+
+// Successive over-relaxation for A x = b; see SOR.cpp for the iteration.
+// x holds the initial guess on entry and the solution on return.
+void SOR(
+    const std::vector<std::vector<double>>& A,
+    const std::vector<double>& b,
+    std::vector<double>& x,
+    double omega,
+    int maxIter = 5000,
+    double tol = 1e-10
+);
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace linear_solver {
+
+inline void print_solution(const std::vector<double>& x)
+{
+    std::cout << std::fixed << std::setprecision(10);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        std::cout << "x" << i + 1 << " = " << x[i] << '\n';
+    }
+}
+
+}
@@ -34,7 +34,8 @@ bisection(Func&& f, double a, double b, const SolverOptions& opt = {})
                 c,
                 iter,
                 true,
-                abs(fc)
+                abs(fc),
+                iter + 2
             };
         }
 
@@ -53,7 +54,8 @@ bisection(Func&& f, double a, double b, const SolverOptions& opt = {})
         c,
         opt.max_iter,
         false,
-        abs(fc)
+        abs(fc),
+        opt.max_iter + 2
     };
 }
 
@@ -1,7 +1,7 @@
 #include <iostream>
 #include <optional>
 #include "bisection.hpp"
-#include "utils.h" 
+#include "../utils.h"
 
 int main() {
     auto f1 = [](double x) {
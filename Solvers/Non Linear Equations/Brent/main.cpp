@@ -0,0 +1,74 @@
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include "brent.hpp"
+#include "../Bisection/bisection.hpp"
+#include "../Regula-Falsi/regula_falsi.hpp"
+
+using namespace nonlinear_solver;
+
+int main() {
+    struct Problem {
+        const char* name;
+        double (*f)(double);
+        double a, b, root;
+    };
+    const Problem problems[] = {
+        {"x^3 - 2x - 5", [](double x) { return x * x * x - 2.0 * x - 5.0; }, 2.0, 3.0, 2.0945514815423265},
+        {"cos x - x", [](double x) { return std::cos(x) - x; }, 0.0, 1.0, 0.7390851332151607},
+        {"e^x - 10", [](double x) { return std::exp(x) - 10.0; }, 0.0, 5.0, std::log(10.0)},
+        // Classic regula falsi keeps the right end for ever here
+        {"x^10 - 1", [](double x) { return std::pow(x, 10.0) - 1.0; }, 0.0, 1.3, 1.0},
+    };
+
+    // Same stopping rule for every method: bisection only honours tol_abs,
+    // so the relative tolerance is switched off for the others too
+    SolverOptions opt;
+    opt.tol_rel = 0.0;
+    opt.max_iter = 500;
+
+    std::cout << std::left << std::setw(14) << "f" << std::right
+              << std::setw(11) << "bisection" << std::setw(9) << "falsi" << std::setw(10) << "Illinois"
+              << std::setw(6) << "A-B" << std::setw(7) << "Brent" << std::setw(10) << "TOMS748" << "\n";
+    for (const auto& p : problems) {
+        auto bisect = bisection(p.f, p.a, p.b, opt);
+        auto classic = regula_falsi(p.f, p.a, p.b, opt);
+        auto illinois = regula_falsi(p.f, p.a, p.b, opt, FalsiVariant::Illinois);
+        auto anderson = regula_falsi(p.f, p.a, p.b, opt, FalsiVariant::AndersonBjorck);
+        auto zeroin = brent(p.f, p.a, p.b, opt);
+        auto alefeld = toms748(p.f, p.a, p.b, opt);
+
+        std::cout << std::left << std::setw(14) << p.name << std::right
+                  << std::setw(11) << bisect->evaluations << std::setw(9) << classic->evaluations
+                  << std::setw(10) << illinois->evaluations << std::setw(6) << anderson->evaluations
+                  << std::setw(7) << zeroin->evaluations << std::setw(10) << alefeld->evaluations << "\n";
+
+        for (const auto& r : {illinois, anderson, zeroin, alefeld}) {
+            assert(r && r->converged);
+            assert(std::fabs(r->root - p.root) < 2e-12);    // as accurate as bisection
+            assert(r->evaluations < bisect->evaluations);
+            assert(r->evaluations <= classic->evaluations);
+        }
+        // Anderson-Bjorck's weight collapses on the flat part of x^10 - 1;
+        // the interpolation-with-safeguard methods do not
+        assert(zeroin->evaluations < bisect->evaluations / 2);
+        assert(alefeld->evaluations < bisect->evaluations / 2);
+    }
+
+    // No sign change
+    assert(!brent([](double x) { return x * x + 1.0; }, -1.0, 1.0));
+    assert(!toms748([](double x) { return x * x + 1.0; }, -1.0, 1.0));
+
+    // A root at an endpoint costs the two initial evaluations
+    auto endpoint = brent([](double x) { return x - 1.0; }, 1.0, 2.0);
+    assert(endpoint && endpoint->root == 1.0 && endpoint->evaluations == 2);
+
+    // Reversed bracket and a discontinuous sign change
+    auto step = toms748([](double x) { return x < 0.3 ? -1.0 : 1.0; }, 1.0, 0.0, opt);
+    assert(step && step->converged && std::fabs(step->root - 0.3) < 1e-10);
+    auto step_brent = brent([](double x) { return x < 0.3 ? -1.0 : 1.0; }, 0.0, 1.0, opt);
+    assert(step_brent && step_brent->converged && std::fabs(step_brent->root - 0.3) < 1e-10);
+
+    return 0;
+}
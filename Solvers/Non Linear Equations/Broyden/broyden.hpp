@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../Newton-Raphson/newton_raphson.hpp"
+
+// Broyden's quasi-Newton method for F(x) = 0, x in R^n.
+//
+// Keeps an approximation H of the inverse Jacobian and corrects it with a
+// rank-one update after every step s = x_new - x, y = F_new - F:
+//
+//   Good:  H += (s - H y) (s^T H) / (s^T H y)     (secant update of J)
+//   Bad:   H += (s - H y) y^T / (y^T y)           (secant update of H)
+//
+// so an iteration costs one system evaluation and O(n^2) work, against
+// 2n + 1 evaluations and an O(n^3) factorization for Newton with a
+// difference Jacobian. H starts from the inverse of the true Jacobian
+// (analytic or by differences), which is recomputed every refresh steps
+// (0: never) and whenever the line search finds no acceptable step.
+//
+// The line search backtracks, x + lambda dx with lambda = 1, 1/2, ...,
+// until ||F||^2 decreases by the Armijo factor; the first trial usually
+// succeeds, and a quasi-Newton direction that is not a descent direction
+// is replaced by a fresh Jacobian instead of being damped to nothing.
+enum class BroydenUpdate { Good, Bad };
+
+struct BroydenOptions
+{
+    double tol = 1e-12;             // on ||F(x)||_2
+    int max_iter = 100;
+    BroydenUpdate update = BroydenUpdate::Good;
+    int refresh = 0;
+    bool line_search = true;
+    double armijo = 1e-4;
+    int max_backtracks = 8;
+    bool verbose = false;
+};
+
+namespace broyden_detail {
+
+template<typename Vec, typename Func, typename Jacobian>
+NewtonResult<Vec> solve(Func&& system, Jacobian&& jacobian, const Vec& x0, const BroydenOptions& opt)
+{
+    using newton_detail::norm;
+    const int n = static_cast<int>(x0.size());
+    NewtonResult<Vec> result{x0, 0, false, 0.0};
+
+    std::vector<double> xv(n), F(n), trial(n), F_trial(n), dx(n), s(n), y(n), Hy(n), row(n);
+    std::vector<double> H(static_cast<std::size_t>(n) * n), J(static_cast<std::size_t>(n) * n);
+    std::vector<int> piv(n);
+
+    auto evaluate = [&](const std::vector<double>& at, std::vector<double>& out) {
+        Vec arg = x0;
+        for (int i = 0; i < n; ++i) arg[i] = at[i];
+        const auto Fx = system(arg);
+        for (int i = 0; i < n; ++i) out[i] = newton_detail::component(Fx, i);
+        ++result.evaluations;
+        return norm(out);
+    };
+    // H = J(x)^-1, column by column from the LU factors
+    auto refresh = [&]() {
+        result.evaluations += jacobian(xv, J);
+        matrix_kernels::lu_factor(J.data(), n, piv.data());
+        ++result.factorizations;
+        for (int j = 0; j < n; ++j) {
+            std::fill(row.begin(), row.end(), 0.0);
+            row[j] = 1.0;
+            matrix_kernels::lu_solve(J.data(), piv.data(), n, row.data());
+            for (int i = 0; i < n; ++i) H[i * n + j] = row[i];
+        }
+    };
+
+    for (int i = 0; i < n; ++i) xv[i] = x0[i];
+    double residual = evaluate(xv, F);
+    int age = -1;                   // updates since the last refresh, -1 before the first
+
+    if (opt.verbose) {
+        std::cout << std::fixed << std::setprecision(12);
+        std::cout << "Iter |                 x                 ||F||           ||dx||\n";
+        std::cout << "---------------------------------------------------------------\n";
+    }
+
+    for (int iter = 1; iter <= opt.max_iter; ++iter)
+    {
+        result.iterations = iter;
+        if (opt.verbose) {
+            std::cout << std::setw(4) << iter << " | ";
+            for (int i = 0; i < std::min(n,4); ++i) std::cout << std::setw(14) << xv[i] << " ";
+            if (n > 4) std::cout << "...";
+            std::cout << "  " << std::scientific << residual;
+        }
+        if (residual < opt.tol) {
+            if (opt.verbose) std::cout << "  ← CONVERGED\n";
+            result.converged = true;
+            break;
+        }
+
+        bool fresh = false;
+        if (age < 0 || (opt.refresh > 0 && age >= opt.refresh)) {
+            try {
+                refresh();
+            } catch (const std::runtime_error&) {
+                if (opt.verbose) std::cout << "  ← SINGULAR JACOBIAN\n";
+                break;
+            }
+            age = 0;
+            fresh = true;
+        }
+
+        // dx = -H F, backtracking; with a stale H retry once after a refresh
+        double lambda = 1.0, trial_residual = 0.0;
+        bool accepted = false;
+        for (;;) {
+            for (int i = 0; i < n; ++i) {
+                double sum = 0.0;
+                for (int j = 0; j < n; ++j) sum += H[i * n + j] * F[j];
+                dx[i] = -sum;
+            }
+            lambda = 1.0;
+            for (int k = 0; k <= opt.max_backtracks; ++k, lambda *= 0.5) {
+                for (int i = 0; i < n; ++i) trial[i] = xv[i] + lambda * dx[i];
+                trial_residual = evaluate(trial, F_trial);
+                if (!opt.line_search) {
+                    accepted = std::isfinite(trial_residual);
+                    break;
+                }
+                if (trial_residual * trial_residual <= (1.0 - 2.0 * opt.armijo * lambda) * residual * residual) {
+                    accepted = true;
+                    break;
+                }
+            }
+            if (accepted || fresh) break;
+            try {
+                refresh();
+            } catch (const std::runtime_error&) {
+                break;
+            }
+            age = 0;
+            fresh = true;
+        }
+
+        if (!accepted) {
+            if (opt.verbose) std::cout << "  ← LINE SEARCH FAILED\n";
+            break;
+        }
+        if (opt.verbose) std::cout << "  " << lambda * norm(dx) << "\n";
+
+        // Rank-one update of H with the accepted step
+        for (int i = 0; i < n; ++i) {
+            s[i] = trial[i] - xv[i];
+            y[i] = F_trial[i] - F[i];
+        }
+        for (int i = 0; i < n; ++i) {
+            double sum = 0.0;
+            for (int j = 0; j < n; ++j) sum += H[i * n + j] * y[j];
+            Hy[i] = s[i] - sum;                  // s - H y
+        }
+        double denominator = 0.0;
+        if (opt.update == BroydenUpdate::Good) {
+            // row = H^T s, denominator = s^T H y
+            std::fill(row.begin(), row.end(), 0.0);
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) row[j] += s[i] * H[i * n + j];
+            }
+            for (int j = 0; j < n; ++j) denominator += row[j] * y[j];
+        } else {
+            row = y;
+            for (int j = 0; j < n; ++j) denominator += y[j] * y[j];
+        }
+        if (std::abs(denominator) > 1e-300) {
+            for (int i = 0; i < n; ++i) {
+                const double scale = Hy[i] / denominator;
+                for (int j = 0; j < n; ++j) H[i * n + j] += scale * row[j];
+            }
+        } else {
+            age = -1;                           // degenerate update: start over
+        }
+
+        xv.swap(trial);
+        F.swap(F_trial);
+        residual = trial_residual;
+        if (age >= 0) ++age;
+    }
+
+    if (!result.converged && residual < opt.tol) {
+        result.converged = true;        // reached by the last step
+    } else if (!result.converged && result.iterations == opt.max_iter && opt.verbose) {
+        std::cout << "  ← MAX ITERATIONS\n";
+    }
+
+    Vec x = x0;
+    for (int i = 0; i < n; ++i) x[i] = xv[i];
+    result.solution = x;
+    result.residual = residual;
+    return result;
+}
+
+}
+
+// Initial and refreshed Jacobians by central differences
+template<typename Vec, typename Func>
+NewtonResult<Vec> broyden(Func&& system, const Vec& x0, const BroydenOptions& opt = {})
+{
+    return broyden_detail::solve(system, newton_detail::difference_jacobian(system, x0), x0, opt);
+}
+
+// Initial and refreshed Jacobians from J(x), a Matrix or a vector of rows
+template<typename Vec, typename Func, typename JacFunc>
+requires std::invocable<JacFunc&, const Vec&>
+NewtonResult<Vec> broyden(Func&& system, JacFunc&& J, const Vec& x0, const BroydenOptions& opt = {})
+{
+    return broyden_detail::solve(system, newton_detail::analytic_jacobian(J, x0), x0, opt);
+}
@@ -0,0 +1,58 @@
+#include "broyden.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+int main()
+{
+    // Broyden's tridiagonal function
+    const int n = 100;
+    auto tridiagonal = [n](const std::vector<double>& x) {
+        std::vector<double> r(n);
+        for (int i = 0; i < n; ++i) {
+            r[i] = (3.0 - 2.0 * x[i]) * x[i] + 1.0;
+            if (i > 0) r[i] -= x[i - 1];
+            if (i + 1 < n) r[i] -= 2.0 * x[i + 1];
+        }
+        return r;
+    };
+    const std::vector<double> start(n, -1.0);
+
+    NewtonOptions newton_opt;
+    newton_opt.tol = 1e-10;
+    auto newton = newton_raphson(tridiagonal, start, newton_opt);
+
+    BroydenOptions opt;
+    opt.tol = 1e-10;
+    auto good = broyden(tridiagonal, start, opt);
+    opt.update = BroydenUpdate::Bad;
+    auto bad = broyden(tridiagonal, start, opt);
+
+    std::cout << "Evaluaciones: Newton " << newton.evaluations << ", Broyden bueno " << good.evaluations
+              << " (" << good.iterations << " iteraciones), Broyden malo " << bad.evaluations << "\n";
+    assert(newton.converged && good.converged && bad.converged);
+    assert(good.residual < 1e-10 && bad.residual < 1e-10);
+    assert(good.evaluations < newton.evaluations / 2);
+    assert(good.factorizations == 1);
+    for (int i = 0; i < n; ++i) {
+        assert(std::fabs(good.solution[i] - newton.solution[i]) < 1e-8);
+        assert(std::fabs(bad.solution[i] - newton.solution[i]) < 1e-8);
+    }
+
+    // Periodic refresh with an analytic Jacobian
+    auto jacobian = [](const std::vector<double>& x) {
+        return std::vector<std::vector<double>>{{2 * x[0], -1.0}, {std::exp(x[0]), -std::sin(x[1])}};
+    };
+    auto system = [](const std::vector<double>& x) {
+        return std::vector<double>{x[0] * x[0] - x[1] - 3.0, std::exp(x[0]) + std::cos(x[1]) - 4.0};
+    };
+    BroydenOptions refreshing;
+    refreshing.refresh = 4;
+    refreshing.verbose = true;
+    auto small = broyden(system, jacobian, std::vector<double>{3.0, 3.0}, refreshing);
+    assert(small.converged && small.residual < 1e-12);
+    assert(std::fabs(small.solution[0] - 1.311743653336) < 1e-9);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "newton_krylov.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace nonlinear_solver;
+
+int main()
+{
+    // Reaction-diffusion u + d (4u - neighbours) + u^3 = 1 on a 200 x 200
+    // grid with zero boundary values: 40000 unknowns, never a matrix
+    const int m = 200;
+    const double d = 1.0;
+    auto laplacian = [m](const std::vector<double>& u, int i, int j) {
+        auto at = [&](int a, int b) { return (a < 0 || b < 0 || a >= m || b >= m) ? 0.0 : u[a * m + b]; };
+        return 4.0 * at(i, j) - at(i - 1, j) - at(i + 1, j) - at(i, j - 1) - at(i, j + 1);
+    };
+    auto reaction = [&](const std::vector<double>& u) {
+        std::vector<double> r(u.size());
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < m; ++j) {
+                const double v = u[i * m + j];
+                r[i * m + j] = v + d * laplacian(u, i, j) + v * v * v - 1.0;
+            }
+        }
+        return r;
+    };
+    auto reaction_jv = [&](const std::vector<double>& u, const std::vector<double>& v) {
+        std::vector<double> r(u.size());
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < m; ++j) {
+                const int k = i * m + j;
+                r[k] = (1.0 + 3.0 * u[k] * u[k]) * v[k] + d * laplacian(v, i, j);
+            }
+        }
+        return r;
+    };
+    const std::vector<double> start(m * m, 0.0);
+
+    NewtonKrylovOptions opt;
+    auto differences = newton_krylov(reaction, start, opt);
+    auto exact = newton_krylov(reaction, start, opt, reaction_jv);
+
+    std::cout << "Reaccion-difusion, n = " << m * m << ": " << differences.iterations << " pasos de Newton, "
+              << differences.linear_iterations << " iteraciones de GMRES, " << differences.evaluations
+              << " evaluaciones, ||F|| = " << differences.residual << "\n";
+    assert(differences.converged && exact.converged);
+    assert(differences.iterations < 15);
+    assert(exact.evaluations == exact.iterations + 1);   // one trial per step, no backtracking
+    for (int k = 0; k < m * m; ++k) {
+        assert(std::fabs(differences.root[k] - exact.root[k]) < 1e-9);
+    }
+    // Far from the boundary u + u^3 = 1
+    const double centre = differences.root[(m / 2) * m + m / 2];
+    assert(std::fabs(centre + centre * centre * centre - 1.0) < 1e-9);
+
+    // Bratu problem -u'' = lambda e^u on (0, 1), u(0) = u(1) = 0, with the
+    // discrete -u'' (tridiagonal, by the Thomas algorithm) as preconditioner
+    const int n = 400;
+    const double h = 1.0 / (n + 1), lambda = 1.0;
+    auto bratu = [&](const std::vector<double>& u) {
+        std::vector<double> r(n);
+        for (int i = 0; i < n; ++i) {
+            const double left = i > 0 ? u[i - 1] : 0.0, right = i + 1 < n ? u[i + 1] : 0.0;
+            r[i] = (2.0 * u[i] - left - right) / (h * h) - lambda * std::exp(u[i]);
+        }
+        return r;
+    };
+    auto inverse_laplacian = [&](const std::vector<double>& v) {
+        std::vector<double> c(n), x(n);
+        const double off = -1.0 / (h * h), diag = 2.0 / (h * h);
+        c[0] = off / diag;
+        x[0] = v[0] / diag;
+        for (int i = 1; i < n; ++i) {
+            const double pivot = diag - off * c[i - 1];
+            c[i] = off / pivot;
+            x[i] = (v[i] - off * x[i - 1]) / pivot;
+        }
+        for (int i = n - 2; i >= 0; --i) x[i] -= c[i] * x[i + 1];
+        return x;
+    };
+
+    NewtonKrylovOptions bratu_opt;
+    bratu_opt.max_linear_iter = 2000;
+    auto plain = newton_krylov(bratu, std::vector<double>(n, 0.0), bratu_opt);
+    auto preconditioned = newton_krylov(bratu, std::vector<double>(n, 0.0), bratu_opt, nullptr, inverse_laplacian);
+
+    std::cout << "Bratu, n = " << n << ": GMRES " << plain.linear_iterations << " iteraciones sin precondicionar, "
+              << preconditioned.linear_iterations << " precondicionado\n";
+    assert(plain.converged && preconditioned.converged);
+    assert(preconditioned.linear_iterations * 5 < plain.linear_iterations);
+    // u(1/2) of the lambda = 1 lower branch
+    const double middle = 0.5 * (preconditioned.root[n / 2 - 1] + preconditioned.root[n / 2]);
+    assert(std::fabs(middle - 0.140539) < 1e-5);
+
+    return 0;
+}
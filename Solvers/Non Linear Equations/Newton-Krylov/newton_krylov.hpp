@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "../utils.h"
+
+namespace nonlinear_solver {
+
+// Jacobian-free Newton-Krylov for large systems F(x) = 0.
+//
+// Each Newton step solves J(x) s = -F(x) only approximately, with
+// restarted GMRES, which needs J only through products J v. By default
+// these are directional differences
+//     J v ≈ (F(x + e v) - F(x)) / e,   e = sqrt(eps) (1 + ||x||) / ||v||,
+// one evaluation of F per Krylov iteration; a jacobian_vector callable
+// (analytic or automatic differentiation) replaces them. No matrix is
+// ever formed, so memory is (restart + 4) vectors of length n.
+//
+// The linear tolerance ||F + J s|| <= eta ||F|| follows Eisenstat and
+// Walker's choice 2, eta = gamma (||F_k|| / ||F_k-1||)^alpha: loose far
+// from the root, where accuracy is wasted, and tight close to it, which
+// keeps the outer convergence superlinear. The step is backtracked until
+// ||F(x + lambda s)|| <= (1 - t (1 - eta)) ||F(x)||.
+//
+// An optional right preconditioner, precondition(v) ≈ J^-1 v, is applied
+// inside GMRES. Converged when ||F|| <= tol_abs + tol_rel ||F(x0)||.
+struct NewtonKrylovOptions : SolverOptions {
+    int    restart        = 30;       // GMRES(m)
+    int    max_linear_iter = 200;     // per Newton step
+    double eta_initial    = 0.5;
+    double eta_max        = 0.9;
+    double gamma          = 0.9;
+    double alpha          = 2.0;
+    bool   line_search    = true;
+    double armijo         = 1e-4;
+    int    max_backtracks = 10;
+};
+
+using Residual = std::function<std::vector<double>(const std::vector<double>&)>;
+// (x, v) -> J(x) v
+using JacobianVector = std::function<std::vector<double>(const std::vector<double>&, const std::vector<double>&)>;
+// v -> M^-1 v
+using Preconditioner = std::function<std::vector<double>(const std::vector<double>&)>;
+
+namespace krylov_detail {
+
+inline double dot(const std::vector<double>& a, const std::vector<double>& b)
+{
+    double s = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) s += a[i] * b[i];
+    return s;
+}
+
+inline double norm(const std::vector<double>& a) { return std::sqrt(dot(a, a)); }
+
+// Restarted GMRES with modified Gram-Schmidt and Givens rotations for
+// A M^-1 u = b, x = M^-1 u, from x = 0. Returns the number of products
+// with A; x receives the solution.
+template<typename Apply, typename Precondition>
+int gmres(Apply&& apply, Precondition&& precondition, const std::vector<double>& b, double tol,
+          int restart, int max_iter, std::vector<double>& x)
+{
+    const std::size_t n = b.size();
+    x.assign(n, 0.0);
+    std::vector<double> r = b;
+    double beta = norm(r);
+    if (beta <= tol) return 0;
+
+    const int m = std::max(1, restart);
+    std::vector<std::vector<double>> V(m + 1, std::vector<double>(n));
+    std::vector<std::vector<double>> H(m + 1, std::vector<double>(m, 0.0));
+    std::vector<double> cs(m), sn(m), g(m + 1), y(m);
+    int products = 0;
+
+    while (products < max_iter) {
+        for (std::size_t i = 0; i < n; ++i) V[0][i] = r[i] / beta;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        int k = 0;
+        for (; k < m && products < max_iter; ++k) {
+            std::vector<double> w = apply(precondition(V[k]));
+            ++products;
+            for (int j = 0; j <= k; ++j) {
+                H[j][k] = dot(w, V[j]);
+                for (std::size_t i = 0; i < n; ++i) w[i] -= H[j][k] * V[j][i];
+            }
+            H[k + 1][k] = norm(w);
+            if (H[k + 1][k] > 0.0) {
+                for (std::size_t i = 0; i < n; ++i) V[k + 1][i] = w[i] / H[k + 1][k];
+            }
+
+            for (int j = 0; j < k; ++j) {
+                const double t = cs[j] * H[j][k] + sn[j] * H[j + 1][k];
+                H[j + 1][k] = -sn[j] * H[j][k] + cs[j] * H[j + 1][k];
+                H[j][k] = t;
+            }
+            const double d = std::hypot(H[k][k], H[k + 1][k]);
+            cs[k] = d > 0.0 ? H[k][k] / d : 1.0;
+            sn[k] = d > 0.0 ? H[k + 1][k] / d : 0.0;
+            H[k][k] = d;
+            H[k + 1][k] = 0.0;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+
+            if (std::abs(g[k + 1]) <= tol || H[k][k] == 0.0) {
+                ++k;
+                break;
+            }
+        }
+
+        // x += M^-1 V y with H y = g
+        for (int i = k - 1; i >= 0; --i) {
+            double s = g[i];
+            for (int j = i + 1; j < k; ++j) s -= H[i][j] * y[j];
+            y[i] = H[i][i] != 0.0 ? s / H[i][i] : 0.0;
+        }
+        std::vector<double> update(n, 0.0);
+        for (int j = 0; j < k; ++j) {
+            for (std::size_t i = 0; i < n; ++i) update[i] += y[j] * V[j][i];
+        }
+        update = precondition(update);
+        for (std::size_t i = 0; i < n; ++i) x[i] += update[i];
+
+        if (std::abs(g[k]) <= tol) break;
+
+        // Restart from the true residual
+        const std::vector<double> Ax = apply(x);
+        ++products;
+        for (std::size_t i = 0; i < n; ++i) r[i] = b[i] - Ax[i];
+        beta = norm(r);
+        if (beta <= tol) break;
+    }
+    return products;
+}
+
+}
+
+inline SystemSolverResult newton_krylov(const Residual& F, std::vector<double> x,
+                                        const NewtonKrylovOptions& opt = {},
+                                        const JacobianVector& jacobian_vector = nullptr,
+                                        const Preconditioner& precondition = nullptr)
+{
+    using krylov_detail::norm;
+    const std::size_t n = x.size();
+    SystemSolverResult result;
+
+    auto evaluate = [&](const std::vector<double>& at) {
+        ++result.evaluations;
+        std::vector<double> r = F(at);
+        if (r.size() != n) throw std::invalid_argument("newton_krylov: F must return one value per unknown");
+        return r;
+    };
+
+    std::vector<double> Fx = evaluate(x);
+    double residual = norm(Fx);
+    const double target = opt.tol_abs + opt.tol_rel * residual;
+    double eta = std::min(opt.eta_initial, opt.eta_max);
+    double previous = residual;
+
+    std::vector<double> rhs(n), step, trial(n), perturbed(n);
+    for (int iter = 1; iter <= opt.max_iter && residual > target; ++iter) {
+        result.iterations = iter;
+
+        // Product with J(x), by differences unless jacobian_vector is given
+        auto apply = [&](const std::vector<double>& v) {
+            if (jacobian_vector) return jacobian_vector(x, v);
+            const double v_norm = norm(v);
+            if (v_norm == 0.0) return std::vector<double>(n, 0.0);
+            const double e = std::sqrt(std::numeric_limits<double>::epsilon()) * (1.0 + norm(x)) / v_norm;
+            for (std::size_t i = 0; i < n; ++i) perturbed[i] = x[i] + e * v[i];
+            std::vector<double> Jv = evaluate(perturbed);
+            for (std::size_t i = 0; i < n; ++i) Jv[i] = (Jv[i] - Fx[i]) / e;
+            return Jv;
+        };
+        auto identity = [](const std::vector<double>& v) { return v; };
+
+        for (std::size_t i = 0; i < n; ++i) rhs[i] = -Fx[i];
+        const double linear_tol = eta * residual;
+        result.linear_iterations += precondition
+            ? krylov_detail::gmres(apply, precondition, rhs, linear_tol, opt.restart, opt.max_linear_iter, step)
+            : krylov_detail::gmres(apply, identity, rhs, linear_tol, opt.restart, opt.max_linear_iter, step);
+
+        // Backtracking on the inexact Newton condition
+        double lambda = 1.0, trial_residual = 0.0;
+        std::vector<double> F_trial;
+        bool accepted = false;
+        for (int k = 0; k <= opt.max_backtracks; ++k) {
+            for (std::size_t i = 0; i < n; ++i) trial[i] = x[i] + lambda * step[i];
+            F_trial = evaluate(trial);
+            trial_residual = norm(F_trial);
+            if (!opt.line_search || trial_residual <= (1.0 - opt.armijo * (1.0 - eta)) * residual) {
+                accepted = std::isfinite(trial_residual);
+                break;
+            }
+            lambda *= 0.5;
+            eta = 1.0 - 0.5 * (1.0 - eta);
+        }
+        if (!accepted) break;
+
+        x.swap(trial);
+        Fx.swap(F_trial);
+        previous = residual;
+        residual = trial_residual;
+
+        // Eisenstat-Walker choice 2 with the safeguards against dropping
+        // eta too fast and over-solving the last step
+        const double eta_old = eta;
+        eta = opt.gamma * std::pow(residual / previous, opt.alpha);
+        const double floor = opt.gamma * std::pow(eta_old, opt.alpha);
+        if (floor > 0.1) eta = std::max(eta, floor);
+        eta = std::min(eta, opt.eta_max);
+        eta = std::max(eta, 0.5 * target / std::max(residual, std::numeric_limits<double>::min()));
+        eta = std::min(eta, opt.eta_max);
+    }
+
+    result.root = std::move(x);
+    result.residual = residual;
+    result.converged = residual <= target;
+    return result;
+}
+
+}
@@ -1,5 +1,7 @@
 #include "Matrix.h"
 #include "newton_raphson.hpp"
+#include <cassert>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <functional>  
@@ -37,6 +39,63 @@ int main()
     } else {
         std::cout << "Failed to converge.\n";
     }
+    assert(result.converged && result.residual < 1e-12);
+
+    // Same system with the Jacobian by differences
+    auto fd = newton_raphson(F, x0, 1e-10, 50, false);
+    assert(fd.converged);
+    assert(std::fabs(fd.solution[0] - result.solution[0]) < 1e-9);
+    assert(std::fabs(fd.solution[1] - result.solution[1]) < 1e-9);
+
+    // Broyden's tridiagonal function with 400 unknowns
+    const int n = 400;
+    auto tridiagonal = [n](const std::vector<double>& x) {
+        std::vector<double> r(n);
+        for (int i = 0; i < n; ++i) {
+            r[i] = (3.0 - 2.0 * x[i]) * x[i] + 1.0;
+            if (i > 0) r[i] -= x[i - 1];
+            if (i + 1 < n) r[i] -= 2.0 * x[i + 1];
+        }
+        return r;
+    };
+    auto tridiagonal_jacobian = [n](const std::vector<double>& x) {
+        std::vector<std::vector<double>> jac(n, std::vector<double>(n, 0.0));
+        for (int i = 0; i < n; ++i) {
+            jac[i][i] = 3.0 - 4.0 * x[i];
+            if (i > 0) jac[i][i - 1] = -1.0;
+            if (i + 1 < n) jac[i][i + 1] = -2.0;
+        }
+        return jac;
+    };
+    const std::vector<double> start(n, -1.0);
+
+    NewtonOptions opt;
+    opt.tol = 1e-10;
+    auto newton = newton_raphson(tridiagonal, tridiagonal_jacobian, start, opt);
+    opt.jacobian_refresh = 3;
+    auto shamanskii = newton_raphson(tridiagonal, tridiagonal_jacobian, start, opt);
+    opt.jacobian_refresh = 0;
+    auto chord = newton_raphson(tridiagonal, tridiagonal_jacobian, start, opt);
+    std::cout << "n = " << n << ": Newton " << newton.iterations << " steps / " << newton.factorizations
+              << " LU, Shamanskii " << shamanskii.iterations << " / " << shamanskii.factorizations
+              << ", chord " << chord.iterations << " / " << chord.factorizations << "\n";
+    assert(newton.converged && shamanskii.converged && chord.converged);
+    assert(shamanskii.factorizations < newton.factorizations);
+    assert(chord.factorizations <= shamanskii.factorizations);
+    for (int i = 0; i < n; ++i) {
+        assert(std::fabs(chord.solution[i] - newton.solution[i]) < 1e-9);
+    }
+
+    // Far from the root the full Newton step overshoots: atan(x) = 0 from
+    // x = 3 diverges undamped and converges with the line search
+    auto arctan = [](const std::vector<double>& x) { return std::vector<double>{std::atan(x[0]), x[1] - 1.0}; };
+    NewtonOptions damped;
+    auto with_search = newton_raphson(arctan, std::vector<double>{3.0, 0.0}, damped);
+    damped.line_search = false;
+    damped.max_iter = 10;
+    auto without_search = newton_raphson(arctan, std::vector<double>{3.0, 0.0}, damped);
+    assert(with_search.converged && std::fabs(with_search.solution[0]) < 1e-12);
+    assert(!without_search.converged);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -6,117 +6,279 @@
 #include <iomanip>
 #include <cmath>
 #include <concepts>
+#include <stdexcept>
+
+#include "../../../Linear Algebra/Matrix/MatrixKernels.h"
+#include "../../../Differentiation/Finite Difference/finite_difference_jacobian.hpp"
 
 template<typename T>
 concept Arithmetic = std::is_arithmetic_v<T>;
 
+// Matrix<T> and anything else with the same element access
 template<typename Mat>
 concept MatrixLike = requires(Mat m, int i, int j, typename Mat::value_type val)
 {
-    { m.rows() } -> std::convertible_to<int>;
-    { m.cols() } -> std::convertible_to<int>;
+    { m.get_num_rows() } -> std::convertible_to<int>;
+    { m.get_num_cols() } -> std::convertible_to<int>;
     { m(i,j) } -> std::convertible_to<typename Mat::value_type&>;
     { m(i,j) = val };
 };
 
-template<typename Vec, MatrixLike Mat>
+template<typename Vec>
 struct NewtonResult
 {
     Vec solution;
     int iterations;
     bool converged;
     double residual;
+    int evaluations = 0;        // system evaluations, Jacobians by differences included
+    int factorizations = 0;     // LU factorizations of the Jacobian
 };
 
-template<typename Vec, typename Func, typename JacFunc, typename Mat>
-requires MatrixLike<Mat>
-NewtonResult<Vec, Mat> newton_raphson(
-    Func&& system,                                     // (x) → F(x), returns vector or Matrix column
-    const Vec& x0,
-    double tol = 1e-12,
-    int max_iter = 50,
-    bool verbose = true)
+// Newton's method for F(x) = 0, x in R^n.
+//
+// Every step solves J dx = -F by LU with partial pivoting, O(n^3) instead
+// of the cofactor inverse. jacobian_refresh controls how long one
+// factorization is reused: 1 is Newton's method, k > 1 the Shamanskii
+// method (a new Jacobian every k steps) and 0 the chord method (a new
+// Jacobian only when the old one stops making progress). A stale
+// Jacobian is also replaced whenever the residual drops by less than
+// stall_ratio.
+//
+// With line_search the step is damped, x + lambda dx with lambda = 1,
+// 1/2, 1/4, ..., until the Armijo condition on ||F||^2 holds; this keeps
+// Newton from diverging far from the root.
+struct NewtonOptions
+{
+    double tol = 1e-12;             // on ||F(x)||_2
+    int max_iter = 50;
+    int jacobian_refresh = 1;
+    double stall_ratio = 0.5;
+    bool line_search = true;
+    double armijo = 1e-4;
+    double min_damping = 1e-10;
+    bool verbose = false;
+};
+
+namespace newton_detail {
+
+// F(x) may be a std::vector-like column or an n x 1 Matrix
+template<typename R>
+double component(const R& r, int i)
+{
+    if constexpr (requires { r(i, 0); }) {
+        return r(i, 0);
+    } else {
+        return r[i];
+    }
+}
+
+inline double norm(const std::vector<double>& v)
+{
+    double s = 0.0;
+    for (double x : v) s += x * x;
+    return std::sqrt(s);
+}
+
+// Jacobian callbacks for solve(): fill the row-major n x n Jacobian at x
+// and return the number of system evaluations it took
+template<typename Vec, typename Func>
+auto difference_jacobian(Func& system, const Vec& x0)
+{
+    return [&system, &x0](const std::vector<double>& x, std::vector<double>& J) {
+        const int n = static_cast<int>(x0.size());
+        auto columns = [&](const std::vector<double>& v) {
+            Vec arg = x0;
+            for (int i = 0; i < n; ++i) arg[i] = v[i];
+            const auto Fx = system(arg);
+            std::vector<double> out(n);
+            for (int i = 0; i < n; ++i) out[i] = component(Fx, i);
+            return out;
+        };
+        J = fd_jacobian(columns, x, JacobianMethod::Centered);
+        return 2 * n + 1;
+    };
+}
+
+// J(x) returning a Matrix or a vector of rows
+template<typename Vec, typename JacFunc>
+auto analytic_jacobian(JacFunc& J, const Vec& x0)
+{
+    return [&J, &x0](const std::vector<double>& x, std::vector<double>& out) {
+        const int n = static_cast<int>(x0.size());
+        Vec arg = x0;
+        for (int i = 0; i < n; ++i) arg[i] = x[i];
+        const auto JF = J(arg);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if constexpr (requires { JF(i, j); }) {
+                    out[i * n + j] = JF(i, j);
+                } else {
+                    out[i * n + j] = JF[i][j];
+                }
+            }
+        }
+        return 0;
+    };
+}
+
+// jacobian(x, J) fills the row-major n x n Jacobian at x and returns the
+// number of system evaluations it took
+template<typename Vec, typename Func, typename Jacobian>
+NewtonResult<Vec> solve(Func&& system, Jacobian&& jacobian, const Vec& x0, const NewtonOptions& opt)
 {
-    using Scalar = typename Vec::value_type;
+    const int n = static_cast<int>(x0.size());
     Vec x = x0;
-    int n = x.size();
-    int iter = 0;
+    NewtonResult<Vec> result{x, 0, false, 0.0};
+
+    std::vector<double> xv(n), F(n), trial(n), F_trial(n), dx(n), LU(static_cast<std::size_t>(n) * n);
+    std::vector<int> piv(n);
+    auto evaluate = [&](const std::vector<double>& at, std::vector<double>& out) {
+        Vec arg = x;
+        for (int i = 0; i < n; ++i) arg[i] = at[i];
+        const auto Fx = system(arg);
+        for (int i = 0; i < n; ++i) out[i] = component(Fx, i);
+        ++result.evaluations;
+        return norm(out);
+    };
+    auto factorize = [&]() {
+        result.evaluations += jacobian(xv, LU);
+        matrix_kernels::lu_factor(LU.data(), n, piv.data());
+        ++result.factorizations;
+    };
+
+    for (int i = 0; i < n; ++i) xv[i] = x0[i];
+    double residual = evaluate(xv, F);
+    int age = -1;                   // steps since the last factorization, -1 before the first
 
-    if (verbose) {
+    if (opt.verbose) {
         std::cout << std::fixed << std::setprecision(12);
         std::cout << "Iter |                 x                 ||F||           ||dx||\n";
         std::cout << "---------------------------------------------------------------\n";
     }
 
-    for (iter = 1; iter <= max_iter; ++iter)
+    for (int iter = 1; iter <= opt.max_iter; ++iter)
     {
-        // Residual F(x) 
-        auto Fx = system(x);                           // Could be std::vector or Matrix column
-        Vec F(n);
-        for (int i = 0; i < n; ++i)
-            F[i] = (Fx.size() ? Fx[i] : Fx(i,0));      // unified access
-
-        double residual = 0.0;
-        for (auto v : F) residual += v*v;
-        residual = std::sqrt(residual);
-
-        if (verbose) {
+        result.iterations = iter;
+        if (opt.verbose) {
             std::cout << std::setw(4) << iter << " | ";
-            for (int i = 0; i < std::min(n,4); ++i) std::cout << std::setw(14) << x[i] << " ";
+            for (int i = 0; i < std::min(n,4); ++i) std::cout << std::setw(14) << xv[i] << " ";
             if (n > 4) std::cout << "...";
             std::cout << "  " << std::scientific << residual;
         }
-
-        if (residual < tol) {
-            if (verbose) std::cout << "  ← CONVERGED\n";
-            return {x, iter, true, residual};
+        if (residual < opt.tol) {
+            if (opt.verbose) std::cout << "  ← CONVERGED\n";
+            result.converged = true;
+            break;
         }
 
-        // Compute Jacobian (finite differences if not provided)
-        Mat J(n, n);
-        Scalar h = 1e-8;
-        for (int j = 0; j < n; ++j) {
-            Vec xph = x, xmh = x;
-            xph[j] += h; xmh[j] -= h;
+        bool fresh = false;
+        if (age < 0 || (opt.jacobian_refresh > 0 && age >= opt.jacobian_refresh)) {
+            try {
+                factorize();
+            } catch (const std::runtime_error&) {
+                if (opt.verbose) std::cout << "  ← SINGULAR JACOBIAN\n";
+                break;
+            }
+            age = 0;
+            fresh = true;
+        }
 
-            auto Fph = system(xph);
-            auto Fmh = system(xmh);
+        // Damped step with the current factorization. A stale one that
+        // gives no acceptable step is refreshed and the step retried.
+        double lambda = 1.0, trial_residual = 0.0;
+        bool accepted = false;
+        for (;;) {
+            for (int i = 0; i < n; ++i) dx[i] = -F[i];
+            matrix_kernels::lu_solve(LU.data(), piv.data(), n, dx.data());
 
-            for (int i = 0; i < n; ++i) {
-                Scalar fph = (Fph.size() ? Fph[i] : Fph(i,0));
-                Scalar fmh = (Fmh.size() ? Fmh[i] : Fmh(i,0));
-                J(i,j) = (fph - fmh) / (2*h);
+            lambda = 1.0;
+            for (;;) {
+                for (int i = 0; i < n; ++i) trial[i] = xv[i] + lambda * dx[i];
+                trial_residual = evaluate(trial, F_trial);
+                if (!opt.line_search) {
+                    accepted = std::isfinite(trial_residual);
+                    break;
+                }
+                if (trial_residual * trial_residual <= (1.0 - 2.0 * opt.armijo * lambda) * residual * residual) {
+                    accepted = true;
+                    break;
+                }
+                // Without a fresh Jacobian dx need not be a descent direction
+                if (!fresh || (lambda *= 0.5) < opt.min_damping) break;
             }
+            if (accepted || fresh) break;
+            try {
+                factorize();
+            } catch (const std::runtime_error&) {
+                break;
+            }
+            age = 0;
+            fresh = true;
         }
 
-        // Solve J Δx = -F 
-        Vec delta(n);
-        try {
-            auto delta_mat = J.inverse() * (-Mat(F));  
-            for (int i = 0; i < n; ++i)
-                delta[i] = delta_mat(i,0);
-        } catch (...) {
-            if (verbose) std::cout << "  ← SINGULAR JACOBIAN\n";
-            return {x, iter, false, residual};
+        if (!accepted) {
+            if (opt.verbose) std::cout << "  ← LINE SEARCH FAILED\n";
+            break;
         }
+        if (opt.verbose) std::cout << "  " << lambda * norm(dx) << "\n";
 
-        double dx_norm = 0.0;
-        for (auto d : delta) dx_norm += d*d;
-        dx_norm = std::sqrt(dx_norm);
-
-        if (verbose) std::cout << "  " << dx_norm << "\n";
+        // A stale Jacobian that barely helps is replaced on the next step
+        const bool stalled = !fresh && trial_residual > opt.stall_ratio * residual;
+        xv.swap(trial);
+        F.swap(F_trial);
+        residual = trial_residual;
+        age = stalled ? -1 : age + 1;
+    }
 
-        // Update
-        for (int i = 0; i < n; ++i) x[i] += delta[i];
+    if (!result.converged && residual < opt.tol) {
+        result.converged = true;        // reached by the last step
+    } else if (!result.converged && result.iterations == opt.max_iter && opt.verbose) {
+        std::cout << "  ← MAX ITERATIONS\n";
     }
 
-    if (verbose) std::cout << "  ← MAX ITERATIONS\n";
-    return {x, iter-1, false, 0.0};
+    for (int i = 0; i < n; ++i) x[i] = xv[i];
+    result.solution = x;
+    result.residual = residual;
+    return result;
+}
+
+}
+
+// Jacobian by central differences (2n + 1 evaluations per Jacobian, the
+// columns in parallel with OpenMP)
+template<typename Vec, typename Func>
+NewtonResult<Vec> newton_raphson(Func&& system, const Vec& x0, const NewtonOptions& opt)
+{
+    return newton_detail::solve(system, newton_detail::difference_jacobian(system, x0), x0, opt);
+}
+
+template<typename Vec, typename Func>
+NewtonResult<Vec> newton_raphson(
+    Func&& system,                                     // (x) → F(x), returns vector or Matrix column
+    const Vec& x0,
+    double tol = 1e-12,
+    int max_iter = 50,
+    bool verbose = true)
+{
+    NewtonOptions opt;
+    opt.tol = tol;
+    opt.max_iter = max_iter;
+    opt.verbose = verbose;
+    return newton_raphson(system, x0, opt);
 }
 
-// Method with analytic Jacobian
+// Method with analytic Jacobian, J(x) returning a Matrix or a vector of rows
 template<typename Vec, typename Func, typename JacFunc>
-auto newton_raphson(
+requires std::invocable<JacFunc&, const Vec&>
+NewtonResult<Vec> newton_raphson(Func&& F, JacFunc&& J, const Vec& x0, const NewtonOptions& opt)
+{
+    return newton_detail::solve(F, newton_detail::analytic_jacobian(J, x0), x0, opt);
+}
+
+template<typename Vec, typename Func, typename JacFunc>
+requires std::invocable<JacFunc&, const Vec&>
+NewtonResult<Vec> newton_raphson(
     Func&& F,
     JacFunc&& J,
     const Vec& x0,
@@ -124,55 +286,9 @@ auto newton_raphson(
     int max_iter = 50,
     bool verbose = true)
 {
-    using Scalar = typename Vec::value_type;
-    using Mat = decltype(J(x0));
-
-    Vec x = x0;
-    int n = x.size();
-
-    if (verbose) {
-        std::cout << std::fixed << std::setprecision(12);
-        std::cout << "Iter |                 x                 ||F||           ||dx||\n";
-        std::cout << "---------------------------------------------------------------\n";
-    }
-
-    for (int iter = 1; iter <= max_iter; ++iter)
-    {
-        auto Fx = F(x);
-        Vec Fvec(n);
-        for (int i = 0; i < n; ++i)
-            Fvec[i] = Fx(i,0);
-
-        double residual = 0.0;
-        for (auto v : Fvec) residual += v*v;
-        residual = std::sqrt(residual);
-
-        if (verbose) {
-            std::cout << std::setw(4) << iter << " | ";
-            for (int i = 0; i < std::min(n,4); ++i)
-                std::cout << std::setw(14) << x[i] << " ";
-            std::cout << "  " << std::scientific << residual;
-        }
-
-        if (residual < tol) {
-            if (verbose) std::cout << "  ← CONVERGED\n";
-            return NewtonResult<Vec, Mat>{x, iter, true, residual};
-        }
-
-        Mat JF = J(x);
-        Mat delta_mat = JF.inverse() * (-Mat(Fvec));
-
-        Vec delta(n);
-        for (int i = 0; i < n; ++i) delta[i] = delta_mat(i,0);
-
-        double dx_norm = 0.0;
-        for (auto d : delta) dx_norm += d*d;
-        dx_norm = std::sqrt(dx_norm);
-
-        if (verbose) std::cout << "  " << dx_norm << "\n";
-
-        for (int i = 0; i < n; ++i) x[i] += delta[i];
-    }
-
-    return NewtonResult<Vec, Mat>{x, max_iter, false, 0.0};
-}
\ No newline at end of file
+    NewtonOptions opt;
+    opt.tol = tol;
+    opt.max_iter = max_iter;
+    opt.verbose = verbose;
+    return newton_raphson(F, J, x0, opt);
+}
@@ -7,11 +7,20 @@ namespace nonlinear_solver {
 // f(a) f(b) < 0. Guarantees that each iterate remains bracketed.
 // Convergence is linear and often slow; stagnation occurs if one
 // endpoint becomes "sticky" (the Illinois modification corrects this).
+//
+// Illinois and Anderson-Bjorck: when the same endpoint is retained twice
+// in a row its function value is scaled by m, which pulls the next
+// interpolant towards it so that both ends move. Illinois uses m = 1/2
+// (order ≈ 1.44); Anderson-Bjorck m = 1 - f(c)/f(replaced end), or 1/2
+// when that is not positive (order ≈ 1.7). Both then stop when the
+// bracket is narrower than tol_abs + tol_rel |c|.
+enum class FalsiVariant { Classic, Illinois, AndersonBjorck };
 
 static std::optional<SolverResult>
 regula_falsi(std::function<double(double)> f,
              double a, double b,
-             const SolverOptions& opt = {})
+             const SolverOptions& opt = {},
+             FalsiVariant variant = FalsiVariant::Classic)
 {
     double fa = f(a);
     double fb = f(b);
@@ -19,6 +28,7 @@ regula_falsi(std::function<double(double)> f,
 
     double c = a;
     double fc = fa;
+    int side = 0;                   // -1: a retained last step, +1: b
 
     for (int iter = 1; iter <= opt.max_iter; ++iter) {
 
@@ -26,18 +36,46 @@ regula_falsi(std::function<double(double)> f,
         c = (fa * b - fb * a) / (fa - fb);
         fc = f(c);
 
-        if (is_converged(b, c, opt) || std::abs(fc) <= opt.tol_abs)
-            return SolverResult{c, iter, true, std::abs(fc)};
+        if (variant == FalsiVariant::Classic) {
+            if (is_converged(b, c, opt) || std::abs(fc) <= opt.tol_abs)
+                return SolverResult{c, iter, true, std::abs(fc), iter + 2};
 
-        // Keep the root inside bracket
+            // Keep the root inside bracket
+            if (fa * fc < 0.0) {
+                b = c; fb = fc;
+            } else {
+                a = c; fa = fc;
+            }
+            continue;
+        }
+
+        if (std::abs(fc) <= opt.tol_abs)
+            return SolverResult{c, iter, true, std::abs(fc), iter + 2};
+
+        // Replace the endpoint with the sign of f(c); down-weight the
+        // other one if it was already retained on the previous step
+        auto weight = [&](double replaced) {
+            if (variant == FalsiVariant::Illinois) return 0.5;
+            const double m = 1.0 - fc / replaced;
+            return m > 0.0 ? m : 0.5;
+        };
         if (fa * fc < 0.0) {
+            const double m = weight(fb);
             b = c; fb = fc;
+            if (side == -1) fa *= m;
+            side = -1;
         } else {
+            const double m = weight(fa);
             a = c; fa = fc;
+            if (side == +1) fb *= m;
+            side = +1;
         }
+
+        if (std::abs(b - a) <= opt.tol_abs + opt.tol_rel * std::abs(c))
+            return SolverResult{c, iter, true, std::abs(fc), iter + 2};
     }
 
-    return SolverResult{c, opt.max_iter, false, std::abs(fc)};
+    return SolverResult{c, opt.max_iter, false, std::abs(fc), opt.max_iter + 2};
 }
 
 } // namespace nonlinear_solver
@@ -29,14 +29,14 @@ secant(std::function<double(double)> f,
 
         // Convergence criteria
         if (is_converged(x1, x2, opt) || std::abs(f2) <= opt.tol_abs)
-            return SolverResult{x2, iter, true, std::abs(f2)};
+            return SolverResult{x2, iter, true, std::abs(f2), iter + 2};
 
         // Shift window
         x0 = x1; f0 = f1;
         x1 = x2; f1 = f2;
     }
 
-    return SolverResult{x1, opt.max_iter, false, std::abs(f1)};
+    return SolverResult{x1, opt.max_iter, false, std::abs(f1), opt.max_iter + 2};
 }
 
 } // namespace nonlinear_solver
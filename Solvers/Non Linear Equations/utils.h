@@ -3,6 +3,7 @@
 #include <optional>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace nonlinear_solver {
 
@@ -11,6 +12,17 @@ struct SolverResult {
     int    iterations{};
     bool   converged{};
     double residual{};
+    int    evaluations{};          // calls to f
+};
+
+// Solvers for systems F(x) = 0; residual is ||F(x)||_2
+struct SystemSolverResult {
+    std::vector<double> root;
+    int    iterations{};
+    bool   converged{};
+    double residual{};
+    int    evaluations{};          // calls to F
+    int    linear_iterations{};    // inner iterations, for inexact Newton methods
 };
 
 struct SolverOptions {
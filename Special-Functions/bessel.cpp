@@ -4,6 +4,7 @@
 namespace special_functions {
 
 template <typename T>
+requires std::is_floating_point_v<T>
 T bessel_j0(T x)
 {
     constexpr int max_iter = 50;
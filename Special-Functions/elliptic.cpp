@@ -5,6 +5,7 @@
 namespace special_functions {
 
 template <typename T>
+requires std::is_floating_point_v<T>
 T elliptic_k(T k)
 {
     if (k < T(0) || k >= T(1))
@@ -1,9 +1,11 @@
 #include "gamma.hpp"
 #include <cmath>
+#include <iterator>
 
 namespace special_functions {
 
 template <typename T>
+requires std::is_floating_point_v<T>
 T gamma(T x)
 {
     static constexpr T g = 7;
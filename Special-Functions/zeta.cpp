@@ -34,6 +34,7 @@ T pochhammer(T x, int n)
 }
 
 template <typename T>
+requires std::is_floating_point_v<T>
 T riemann_zeta(T s)
 {
     if (s <= T(1))